@@ -0,0 +1,35 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+// Compiled (not linked) by the SenderCheck target so that CI catches breakage in the header-only Sender.hpp, which the
+// library itself never includes.
+
+#include "motdpe/Sender.hpp"
+#include <concepts>
+#include <utility>
+
+namespace motdpe::checks {
+
+static_assert(stdexec::sender<PingSender>);
+static_assert(stdexec::sender<PingScheduler::Sender>);
+static_assert(stdexec::scheduler<PingScheduler>);
+static_assert(std::same_as<
+              decltype(stdexec::get_completion_scheduler<stdexec::set_value_t>(
+                  stdexec::get_env(std::declval<const PingSender&>())
+              )),
+              PingScheduler>);
+
+// Instantiates both operation states with stdexec's own receivers, stop tokens and adaptors.
+void compose(PingContext& context, const Endpoint& first, const Endpoint& second) {
+    auto both = stdexec::when_all(pingSender(context, first), pingSender(context, second));
+    [[maybe_unused]] auto motds = stdexec::sync_wait(std::move(both));
+
+    auto hop = stdexec::schedule(pingScheduler(context)) | stdexec::then([] {});
+    stdexec::sync_wait(std::move(hop));
+}
+
+} // namespace motdpe::checks
\ No newline at end of file
@@ -0,0 +1,120 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Monitor.hpp"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace motdpe {
+
+namespace detail {
+class AlertEvaluator;
+}
+
+// Value of a target that a rule watches. Pong fields keep their last known value while the target is down.
+enum class AlertField : uint8_t {
+    // 1 while the target answers, 0 after a failed probe.
+    Up,
+    Players,
+    MaxPlayers,
+    // Online / max players, 0 when the server reports no maximum.
+    PlayerRatio,
+    Protocol,
+    // Milliseconds.
+    Rtt,
+    Version,
+    Motd,
+    GameMode,
+};
+
+enum class AlertOp : uint8_t {
+    Equal,
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    // Fires once every time the value changes, e.g. on a version upgrade; never resolves.
+    Changed,
+};
+
+// Condition on one field, e.g. {.field = AlertField::Up, .op = AlertOp::Equal, .value = 0, .holdFor = 2min} for
+// "down for more than two minutes".
+struct AlertRule {
+    std::string name;
+    AlertField  field = AlertField::Up;
+    AlertOp     op    = AlertOp::Equal;
+    // Threshold for numeric fields.
+    double value = 0;
+    // Operand for Version, Motd and GameMode, which support Equal, NotEqual and Changed only.
+    std::string text;
+    // The condition must hold continuously for this long before the alert fires.
+    std::chrono::milliseconds holdFor{0};
+    // Restricts the rule to one target id; 0 applies it to every target.
+    uint64_t target = 0;
+};
+
+enum class AlertState : uint8_t {
+    Firing,
+    Resolved,
+};
+
+struct Alert {
+    uint64_t                              ruleId;
+    const AlertRule&                      rule;
+    uint64_t                              target;
+    AlertState                            state;
+    std::chrono::system_clock::time_point at;
+    // Current value of the watched field; `text` is set for text fields.
+    double           value = 0;
+    std::string_view text;
+};
+
+// Rule engine fed with monitor results. Rules are indexed by the field they watch (and by target for targeted
+// rules), and each result only evaluates the rules of fields whose value changed. Conditions with a hold time arm a
+// timer on a timing wheel instead of being re-checked, so the cost per result does not grow with the number of
+// targets or unrelated rules.
+//
+// Rules can be added and removed from any thread without blocking evaluation. process(), forget() and advance()
+// must come from one thread; a monitor with this engine in MonitorOptions::alerts calls them on its scheduler
+// thread, and the sink is invoked there too.
+class AlertEngine {
+public:
+    using Sink = std::function<void(const Alert&)>;
+
+    explicit AlertEngine(Sink sink);
+    ~AlertEngine();
+
+    AlertEngine(const AlertEngine&)            = delete;
+    AlertEngine& operator=(const AlertEngine&) = delete;
+
+    // Sink appending one JSON object per line to `path`; throws if the file cannot be opened.
+    static Sink fileSink(const std::filesystem::path& path);
+
+    // Existing targets are evaluated against a new rule on the next processing call. Throws for an op the field does
+    // not support, i.e. Less, LessEqual, Greater or GreaterEqual on a text field. Thread-safe.
+    uint64_t addRule(AlertRule rule);
+    // Drops the rule and its pending and firing state without further alerts. Thread-safe.
+    bool removeRule(uint64_t id);
+
+    void process(const MonitorEvent& event, std::chrono::steady_clock::time_point now);
+    // Drops the state of a removed target.
+    void forget(uint64_t target);
+    // Fires rules whose hold time elapsed.
+    void advance(std::chrono::steady_clock::time_point now);
+
+private:
+    std::unique_ptr<detail::AlertEvaluator> mEvaluator;
+};
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,61 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/BatchColumns.hpp"
+#include "motdpe/StatusTable.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace motdpe {
+
+namespace detail {
+class ArrowFileWriter;
+}
+
+// Columns of an exported file. Pong fields are null for targets without a pong.
+enum class ArrowTable : uint8_t {
+    // Batch and scan results from BatchColumns: target, address, port, ok, rtt_us, online, max, protocol, edition,
+    // version, game_mode, motd, sub_motd, error.
+    Scan,
+    // Latest monitor state from a StatusTable or StatusReader: id, updated_at, ok, failures, rtt_us, online, max,
+    // protocol, edition, version, game_mode, motd, sub_motd.
+    Status,
+};
+
+// Writes results as an Arrow IPC file (Feather v2), which pyarrow, pandas, polars and DuckDB can memory-map and read
+// without parsing or copying. Every write() appends record batches; edition, version and game mode are
+// dictionary-encoded, and each batch adds only the values it introduces as a dictionary delta. Numeric and text
+// columns of BatchColumns are written straight from their buffers.
+//
+// The file is only readable once close() returned or the writer was destroyed. Not thread-safe.
+class ArrowWriter {
+public:
+    // Creates or truncates the file; throws on I/O failure.
+    ArrowWriter(const std::filesystem::path& path, ArrowTable table);
+    ~ArrowWriter();
+
+    ArrowWriter(const ArrowWriter&)            = delete;
+    ArrowWriter& operator=(const ArrowWriter&) = delete;
+
+    // Throws if the writer does not export ArrowTable::Scan, or on I/O failure.
+    void write(const BatchColumns& columns);
+    // Snapshot of every live record, in batches of up to 64k rows. Throws if the writer does not export
+    // ArrowTable::Status, or on I/O failure.
+    void write(const StatusTable& table);
+    void write(const StatusReader& reader);
+
+    // Writes the footer; further writes throw. Throws on I/O failure.
+    void close();
+
+private:
+    std::unique_ptr<detail::ArrowFileWriter> mWriter;
+    ArrowTable                               mTable;
+};
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,207 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+// Optional integration with standalone Asio; only translation units that include this header need Asio.
+
+#pragma once
+#include "motdpe/Pong.hpp"
+#include <array>
+#include <asio.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+
+namespace motdpe {
+
+namespace detail {
+
+// Composed operation behind asyncQueryMotd: resolve, then ping every resolved address in turn until one answers
+// within `timeout`. Runs entirely on the caller's executor; per-operation cancellation is forwarded to whichever
+// resolve, send or receive is outstanding.
+class AsioQueryOp {
+public:
+    AsioQueryOp(
+        const asio::any_io_executor& executor,
+        std::string                  host,
+        uint16_t                     port,
+        std::chrono::milliseconds    timeout
+    )
+    : mState(std::make_shared<State>(executor, std::move(host), port, timeout)) {}
+
+    template <typename Self>
+    void operator()(Self& self) {
+        auto& state = *mState;
+        state.resolver.async_resolve(state.host, std::to_string(state.port), std::move(self));
+    }
+
+    template <typename Self>
+    void operator()(Self& self, asio::error_code ec, asio::ip::udp::resolver::results_type results) {
+        if (ec) return complete(self, ec);
+        mState->results = std::move(results);
+        mState->next    = mState->results.begin();
+        pingNext(self);
+    }
+
+    template <typename Self>
+    void operator()(Self& self, asio::error_code ec, size_t bytes) {
+        auto& state = *mState;
+        if (ec == asio::error::operation_aborted) {
+            if (!state.timedOut) return complete(self, ec);
+            return pingNext(self);
+        }
+        if (ec) return pingNext(self);
+
+        if (state.step == Step::Sending) {
+            state.step = Step::Receiving;
+            return receive(self);
+        }
+
+        const auto packet = std::span<const std::byte>{state.buffer.data(), bytes};
+        if (state.from == state.target) {
+            if (const auto payload = pongPayload(packet)) return complete(self, {}, std::string{*payload});
+        }
+        receive(self);
+    }
+
+private:
+    enum class Step { Sending, Receiving };
+
+    struct State {
+        State(const asio::any_io_executor& executor, std::string host, uint16_t port, std::chrono::milliseconds timeout)
+        : resolver(executor),
+          socket(executor),
+          timer(executor),
+          host(std::move(host)),
+          port(port),
+          timeout(timeout) {}
+
+        asio::ip::udp::resolver                         resolver;
+        asio::ip::udp::socket                           socket;
+        asio::steady_timer                              timer;
+        std::string                                     host;
+        uint16_t                                        port;
+        std::chrono::milliseconds                       timeout;
+        asio::ip::udp::resolver::results_type           results;
+        asio::ip::udp::resolver::results_type::iterator next;
+        asio::ip::udp::endpoint                         target;
+        asio::ip::udp::endpoint                         from;
+        std::array<std::byte, 33>                       ping{};
+        std::array<std::byte, 2048>                     buffer{};
+        Step                                            step     = Step::Sending;
+        uint32_t                                        attempt  = 0;
+        bool                                            timedOut = false;
+        bool                                            sent     = false;
+    };
+
+    template <typename Self>
+    void pingNext(Self& self) {
+        auto& state = *mState;
+        state.timer.cancel();
+        state.socket.close();
+        state.timedOut = false;
+
+        for (; state.next != state.results.end(); ++state.next) {
+            asio::error_code ec;
+            state.target = state.next->endpoint();
+            state.socket.open(state.target.protocol(), ec);
+            if (!ec) break;
+        }
+        if (state.next == state.results.end()) {
+            return complete(self, state.sent ? asio::error::timed_out : asio::error::host_unreachable);
+        }
+        ++state.next;
+
+        // A timed-out attempt cancels the socket; the receive then completes with operation_aborted. cancel() cannot
+        // recall a timer handler that has already been queued, so a handler left over from an earlier attempt is
+        // recognised by its attempt number and ignored.
+        state.timer.expires_after(state.timeout);
+        state.timer.async_wait([weak = std::weak_ptr<State>{mState}, attempt = ++state.attempt](asio::error_code ec) {
+            const auto locked = weak.lock();
+            if (ec || !locked || locked->attempt != attempt) return;
+            locked->timedOut = true;
+            locked->socket.cancel();
+        });
+
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        state.ping     = makePingPacket(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count())
+        );
+        state.step = Step::Sending;
+        state.sent = true;
+        state.socket.async_send_to(asio::buffer(state.ping), state.target, std::move(self));
+    }
+
+    template <typename Self>
+    void receive(Self& self) {
+        auto& state = *mState;
+        state.socket.async_receive_from(asio::buffer(state.buffer), state.from, std::move(self));
+    }
+
+    template <typename Self>
+    void complete(Self& self, asio::error_code ec, std::string motd = {}) {
+        ++mState->attempt;
+        mState->timer.cancel();
+        mState->socket.close();
+        self.complete(ec, std::move(motd));
+    }
+
+    std::shared_ptr<State> mState;
+};
+
+} // namespace detail
+
+// Asio initiating function for a MOTD query. Completes with (asio::error_code, std::string); the error is
+// asio::error::timed_out when no resolved address answered in time and operation_aborted on cancellation. Accepts any
+// completion token, e.g. a callback, asio::use_future or asio::use_awaitable.
+template <typename CompletionToken>
+auto asyncQueryMotd(
+    const asio::any_io_executor& executor,
+    std::string                  host,
+    uint16_t                     port,
+    std::chrono::milliseconds    timeout,
+    CompletionToken&&            token
+) {
+    return asio::async_compose<CompletionToken, void(asio::error_code, std::string)>(
+        detail::AsioQueryOp{executor, std::move(host), port, timeout},
+        token,
+        executor
+    );
+}
+
+template <typename CompletionToken>
+auto asyncQueryMotd(
+    asio::io_context&         context,
+    std::string               host,
+    uint16_t                  port,
+    std::chrono::milliseconds timeout,
+    CompletionToken&&         token
+) {
+    return asyncQueryMotd(
+        asio::any_io_executor{context.get_executor()},
+        std::move(host),
+        port,
+        timeout,
+        std::forward<CompletionToken>(token)
+    );
+}
+
+template <typename CompletionToken>
+auto asyncQueryMotd(asio::io_context& context, std::string host, uint16_t port, CompletionToken&& token) {
+    return asyncQueryMotd(
+        context,
+        std::move(host),
+        port,
+        std::chrono::seconds(5),
+        std::forward<CompletionToken>(token)
+    );
+}
+
+} // namespace motdpe
\ No newline at end of file
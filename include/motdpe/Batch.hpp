@@ -0,0 +1,44 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/RateController.hpp"
+#include "motdpe/Transport.hpp"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace motdpe {
+
+struct BatchTarget {
+    std::string host;
+    uint16_t    port = 19132;
+};
+
+struct BatchResult {
+    std::optional<std::string> motd;
+    std::chrono::microseconds  rtt{0};
+    std::string                error;
+
+    [[nodiscard]] bool ok() const noexcept { return motd.has_value(); }
+};
+
+struct BatchOptions {
+    std::chrono::milliseconds timeout = std::chrono::seconds(5);
+    // Send pacing per source; set minRate == maxRate for a fixed rate.
+    RateControllerOptions rate{};
+    TransportOptions      transport{};
+};
+
+// Pings every target from non-blocking sockets, each source paced by a loss-aware AIMD rate controller.
+// Results are returned in target order; targets resolving to the same endpoint share one ping.
+std::vector<BatchResult> queryMotdBatch(std::span<const BatchTarget> targets, const BatchOptions& options = {});
+
+} // namespace motdpe
\ No newline at end of file
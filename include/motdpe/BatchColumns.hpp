@@ -0,0 +1,110 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Batch.hpp"
+#include "motdpe/Endpoint.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace motdpe {
+
+// Strings stored back to back: row i is bytes()[offsets()[i], offsets()[i + 1]), the layout of an Arrow utf8 array.
+class TextColumn {
+public:
+    // Throws once the column would exceed 4 GiB.
+    void push_back(std::string_view text);
+    // Appends a copy of an existing row.
+    void duplicate(size_t row);
+    void reserve(size_t rows, size_t bytes);
+
+    // Whether `bytes` more can be appended without exceeding 4 GiB.
+    [[nodiscard]] bool fits(size_t bytes) const noexcept { return bytes <= UINT32_MAX - mBytes.size(); }
+
+    [[nodiscard]] std::string_view operator[](size_t row) const noexcept {
+        return std::string_view{mBytes}.substr(mOffsets[row], mOffsets[row + 1] - mOffsets[row]);
+    }
+
+    [[nodiscard]] size_t                    size() const noexcept { return mOffsets.size() - 1; }
+    [[nodiscard]] std::span<const uint32_t> offsets() const noexcept { return mOffsets; }
+    [[nodiscard]] std::string_view          bytes() const noexcept { return mBytes; }
+
+private:
+    std::vector<uint32_t> mOffsets{0};
+    std::string           mBytes;
+};
+
+// Low-cardinality strings interned per column: every row holds an index into values(). Index 0 is always the empty
+// string, which rows without a value use.
+class DictionaryColumn {
+public:
+    DictionaryColumn();
+
+    void push_back(std::string_view value);
+    void duplicate(size_t row) { mIds.push_back(mIds[row]); }
+    void reserve(size_t rows) { mIds.reserve(rows); }
+
+    [[nodiscard]] std::string_view operator[](size_t row) const noexcept { return mValues[mIds[row]]; }
+
+    [[nodiscard]] size_t                       size() const noexcept { return mIds.size(); }
+    [[nodiscard]] std::span<const uint32_t>    ids() const noexcept { return mIds; }
+    [[nodiscard]] std::span<const std::string> values() const noexcept { return mValues; }
+
+private:
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view key) const noexcept { return std::hash<std::string_view>{}(key); }
+    };
+
+    std::vector<uint32_t>                                                mIds;
+    std::vector<std::string>                                             mValues;
+    std::unordered_map<std::string, uint32_t, KeyHash, std::equal_to<>> mLookup;
+};
+
+// Structure-of-arrays batch results: one contiguous column per field instead of one object per server, so a pass
+// over a single field (say the sum of `online` over 100k servers) streams through one dense array that compilers
+// vectorise, rather than striding over whole results. Pongs are parsed straight into the columns.
+//
+// Rows follow completion order; `target` maps each row back to its index in the target list. Rows with `ok` == 0
+// have zero numeric fields, empty text and dictionary id 0, and their reason in `error`.
+struct BatchColumns {
+    std::vector<uint32_t> target;
+    std::vector<Endpoint> endpoint;
+    // 1 if a well-formed pong arrived.
+    std::vector<uint8_t>  ok;
+    std::vector<uint32_t> rttUs;
+    std::vector<int32_t>  online;
+    std::vector<int32_t>  max;
+    std::vector<int32_t>  protocol;
+    DictionaryColumn      edition;
+    DictionaryColumn      version;
+    DictionaryColumn      gameMode;
+    TextColumn            motd;
+    TextColumn            subMotd;
+    TextColumn            error;
+
+    [[nodiscard]] size_t size() const noexcept { return target.size(); }
+
+    void reserve(size_t rows);
+    // Each append adds a full row or, when a text column would exceed 4 GiB, throws and leaves every column as it was.
+    // Parses a server id string into a new row; a malformed one becomes a failed row.
+    void appendPong(uint32_t index, const Endpoint& address, std::string_view payload, std::chrono::microseconds rtt);
+    void appendFailure(uint32_t index, const Endpoint& address, std::string_view reason);
+    // Appends a copy of `row` for another target.
+    void duplicate(size_t row, uint32_t index);
+};
+
+// Like queryMotdBatch(), with the results in columns.
+BatchColumns queryMotdBatchColumns(std::span<const BatchTarget> targets, const BatchOptions& options = {});
+
+} // namespace motdpe
\ No newline at end of file
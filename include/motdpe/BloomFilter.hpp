@@ -0,0 +1,47 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Endpoint.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace motdpe {
+
+// Blocked Bloom filter: every key maps to a single cache-line-sized block and sets one bit in each of its eight
+// 64-bit words, so a probe touches one cache line and is evaluated with a handful of vector instructions. May report
+// false positives, never false negatives. Not thread-safe.
+class BloomFilter {
+public:
+    // Sized for `expectedItems` keys at roughly `falsePositiveRate`.
+    explicit BloomFilter(uint64_t expectedItems, double falsePositiveRate = 0.001);
+
+    [[nodiscard]] bool contains(uint64_t hash) const noexcept;
+    // Adds the key; false if it was (probably) present already.
+    bool insert(uint64_t hash) noexcept;
+    void clear() noexcept;
+
+    [[nodiscard]] size_t memoryBytes() const noexcept { return mBlocks.size() * sizeof(Block); }
+
+    [[nodiscard]] static uint64_t hash(const Endpoint& endpoint) noexcept;
+    [[nodiscard]] static uint64_t hash(std::string_view key) noexcept;
+
+private:
+    struct alignas(64) Block {
+        std::array<uint64_t, 8> words{};
+    };
+
+    [[nodiscard]] Block&       blockFor(uint64_t hash) noexcept;
+    [[nodiscard]] const Block& blockFor(uint64_t hash) const noexcept;
+
+    std::vector<Block> mBlocks;
+};
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,65 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace motdpe {
+
+// A resolved UDP endpoint. IPv4 addresses occupy the first four bytes of `address` in network order.
+struct Endpoint {
+    std::array<uint8_t, 16> address{};
+    uint16_t                port = 0;
+    bool                    ipv6 = false;
+
+    // Parses a numeric IPv4 or IPv6 address; hostnames are not resolved.
+    [[nodiscard]] static std::optional<Endpoint> parse(std::string_view address, uint16_t port);
+
+    // Resolves a hostname or numeric address; throws on resolution failure.
+    [[nodiscard]] static std::vector<Endpoint> resolve(std::string_view host, uint16_t port);
+
+    [[nodiscard]] static constexpr Endpoint fromV4(uint32_t address, uint16_t port) noexcept {
+        Endpoint endpoint;
+        endpoint.address[0] = static_cast<uint8_t>(address >> 24);
+        endpoint.address[1] = static_cast<uint8_t>(address >> 16);
+        endpoint.address[2] = static_cast<uint8_t>(address >> 8);
+        endpoint.address[3] = static_cast<uint8_t>(address);
+        endpoint.port       = port;
+        return endpoint;
+    }
+
+    [[nodiscard]] constexpr uint32_t v4() const noexcept {
+        return static_cast<uint32_t>(address[0]) << 24 | static_cast<uint32_t>(address[1]) << 16
+             | static_cast<uint32_t>(address[2]) << 8 | static_cast<uint32_t>(address[3]);
+    }
+
+    // "1.2.3.4" or "2001:db8::1".
+    [[nodiscard]] std::string addressString() const;
+    // "1.2.3.4:19132" or "[2001:db8::1]:19132".
+    [[nodiscard]] std::string toString() const;
+
+    constexpr auto operator<=>(const Endpoint&) const noexcept = default;
+};
+
+struct EndpointHash {
+    size_t operator()(const Endpoint& endpoint) const noexcept {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (const uint8_t byte : endpoint.address) hash = (hash ^ byte) * 0x100000001b3ull;
+        hash = (hash ^ endpoint.port) * 0x100000001b3ull;
+        hash = (hash ^ static_cast<uint64_t>(endpoint.ipv6)) * 0x100000001b3ull;
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+};
+
+} // namespace motdpe
\ No newline at end of file
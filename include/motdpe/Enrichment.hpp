@@ -0,0 +1,59 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Endpoint.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace motdpe {
+
+struct EnrichmentOptions {
+    // Hosts enriched at the same time.
+    size_t concurrency = 32;
+    // Hits waiting for enrichment. The scan stops sending new pings while the queue is full, and hits that still
+    // arrive then are reported but not enriched (ScanStats::unenriched).
+    size_t queueCapacity = 1024;
+    // Additional pings used to sample the RTT; 0 disables.
+    uint32_t rttSamples = 3;
+    // Full-stat request over the GameSpy4 query protocol (enable-query in server.properties).
+    bool queryPlayers = true;
+    // RakNet OpenConnectionRequest1 probes with the don't-fragment bit set.
+    bool probeMtu = true;
+    // Per exchange.
+    std::chrono::milliseconds timeout = std::chrono::seconds(1);
+};
+
+struct QueryInfo {
+    std::vector<std::pair<std::string, std::string>> values;
+    std::vector<std::string>                         players;
+};
+
+struct Enrichment {
+    std::vector<std::chrono::microseconds> rttSamples;
+    std::optional<QueryInfo>               query;
+    std::optional<uint16_t>                mtu;
+};
+
+// Single unconnected ping; nothing on timeout.
+std::optional<std::chrono::microseconds> pingRtt(const Endpoint& endpoint, std::chrono::milliseconds timeout);
+
+// GameSpy4 handshake plus full-stat request; nothing when the server does not answer.
+std::optional<QueryInfo> queryFullStat(const Endpoint& endpoint, std::chrono::milliseconds timeout);
+
+// Largest MTU from a descending probe ladder that the server acknowledges; nothing when no probe is answered.
+std::optional<uint16_t> probeMtu(const Endpoint& endpoint, std::chrono::milliseconds timeout);
+
+// Runs the follow-ups selected in `options` one after another.
+Enrichment enrich(const Endpoint& endpoint, const EnrichmentOptions& options);
+
+} // namespace motdpe
\ No newline at end of file
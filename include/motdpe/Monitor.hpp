@@ -0,0 +1,147 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Endpoint.hpp"
+#include "motdpe/PayloadStore.hpp"
+#include "motdpe/Pong.hpp"
+#include "motdpe/RateController.hpp"
+#include "motdpe/RttEstimator.hpp"
+#include "motdpe/StatusTable.hpp"
+#include "motdpe/Transport.hpp"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace motdpe {
+
+namespace detail {
+class MonitorScheduler;
+}
+
+class AlertEngine;
+class ServerIndex;
+class StatusServer;
+class TextIndex;
+
+// Strict priority: a lane is only served while every higher lane has nothing due.
+enum class Priority : uint8_t {
+    High,
+    Normal,
+    Bulk,
+};
+
+struct MonitorTarget {
+    std::string               host;
+    uint16_t                  port     = 19132;
+    std::chrono::milliseconds interval = std::chrono::seconds(30);
+    Priority                  priority = Priority::Normal;
+    // Tenants share the packet budget of a lane by weight; see Monitor::setTenantWeight().
+    std::string tenant;
+};
+
+struct MonitorOptions {
+    // Global packet budget shared by all tenants.
+    RateControllerOptions rate{};
+    TransportOptions      transport{};
+    // Per-target timeouts follow the target's smoothed RTT. A probe resends its ping after every hedge delay and only
+    // counts as failed once the whole timeout passed without a pong.
+    RttOptions rtt{};
+    // Consecutive failures double the interval of a target up to this bound.
+    std::chrono::milliseconds maxBackoff = std::chrono::minutes(10);
+    // Receives the latest state of every target after each probe, for lock-free readers on other threads. Size it for
+    // every target: records that do not fit are dropped and counted in StatusTable::rejected().
+    std::shared_ptr<StatusTable> status;
+    // Serves `status` over HTTP; every record the monitor publishes or erases invalidates its cached response.
+    std::shared_ptr<StatusServer> server;
+    // Evaluates alert rules against every probe result on the scheduler thread.
+    std::shared_ptr<AlertEngine> alerts;
+    // Kept current with the latest pong and liveness of every target for filtered server list queries. Index updates
+    // run on a separate thread that the monitor starts alongside the scheduler, which never waits on an index lock.
+    std::shared_ptr<ServerIndex> index;
+    // Re-indexed with the MOTD and sub-MOTD of a target whenever its pong changes, for text search.
+    std::shared_ptr<TextIndex> text;
+    // Holds every distinct pong payload once; events carry its id, so a history records 16 bytes per probe.
+    std::shared_ptr<PayloadStore> payloads;
+};
+
+struct MonitorEvent {
+    uint64_t                  id;
+    const MonitorTarget&      target;
+    Endpoint                  endpoint;
+    // Raw pong payload; empty on timeout.
+    std::string_view          motd;
+    // Id of `motd` in MonitorOptions::payloads; zero without a store or on timeout.
+    PayloadId                 payload;
+    std::optional<Pong>       pong;
+    std::chrono::microseconds rtt{0};
+    // Consecutive failed probes, 0 after a pong.
+    uint32_t failures = 0;
+    // The pong payload differs from the previous one, or the target went up or down; RTT changes alone do not count.
+    bool changed = false;
+
+    [[nodiscard]] bool ok() const noexcept { return failures == 0; }
+};
+
+// Periodic pinger for a long-lived target list. A single scheduler thread spreads every target's first probe across
+// its interval, hands due targets to a priority/fair queue and sends them through the loss-aware rate controller, so
+// the combined packet rate stays within one budget regardless of how many targets each tenant registers. Targets can
+// be added, updated and removed while the monitor runs; changes are published as epochs that the scheduler picks up
+// without taking a lock.
+class Monitor {
+public:
+    // Called on the scheduler thread after every probe.
+    using Callback = std::function<void(const MonitorEvent&)>;
+
+    Monitor() : Monitor(MonitorOptions{}) {}
+    explicit Monitor(MonitorOptions options);
+    ~Monitor();
+
+    Monitor(const Monitor&)            = delete;
+    Monitor& operator=(const Monitor&) = delete;
+
+    // Resolves the host and registers the target; throws on resolution failure. Thread-safe.
+    uint64_t add(MonitorTarget target);
+
+    // Stops probing a target; an outstanding probe is dropped. Returns false for unknown ids. Thread-safe.
+    bool remove(uint64_t id);
+
+    // Replaces the settings of a target, re-resolving the host if the address changed; throws on resolution failure.
+    // RTT estimate and failure count are kept, and the next probe keeps the target's phase under the new interval.
+    // Returns false for unknown ids. Thread-safe.
+    bool update(uint64_t id, MonitorTarget target);
+
+    // Number of registered targets, including changes the scheduler has not picked up yet.
+    [[nodiscard]] size_t size() const;
+
+    // Writes every target with its resolved address, RTT and back-off state, schedule phase and last pong, plus the
+    // tenant weights, to a compact snapshot file. The monitor must be stopped; throws on I/O failure.
+    void save(const std::filesystem::path& path);
+
+    // Loads a snapshot written by save() into a stopped monitor that never had targets, without resolving any host.
+    // Ids are preserved and each schedule keeps its phase across the downtime, so a restart does not burst. Returns
+    // the number of restored targets; throws on unreadable or malformed files.
+    size_t restore(const std::filesystem::path& path);
+
+    // Share of the packet budget of a tenant relative to the other tenants in the same lane (default 1). Thread-safe.
+    void setTenantWeight(std::string_view tenant, uint32_t weight);
+
+    void start(Callback callback);
+    void stop();
+
+    [[nodiscard]] bool running() const noexcept;
+
+private:
+    std::unique_ptr<detail::MonitorScheduler> mScheduler;
+};
+
+} // namespace motdpe
\ No newline at end of file
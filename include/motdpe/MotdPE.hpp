@@ -6,6 +6,7 @@
 // SPDX-License-Identifier: MPL-2.0
 
 #pragma once
+#include <chrono>
 #include <functional>
 #include <future>
 #include <optional>
@@ -14,12 +15,24 @@
 
 namespace motdpe {
 
+class RttCache;
+struct Endpoint;
+
 std::string
 queryMotd(std::string_view host, uint16_t port, std::chrono::milliseconds timeout = std::chrono::seconds(5));
 
+// Pings an already resolved endpoint.
+std::string queryMotd(const Endpoint& endpoint, std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
+// Derives the timeout and hedged retransmit delay from the endpoint's smoothed RTT and feeds the measured RTT back.
+std::string queryMotd(std::string_view host, uint16_t port, RttCache& rtt);
+
 std::future<std::string>
 queryMotdAsync(std::string_view host, uint16_t port, std::chrono::milliseconds timeout = std::chrono::seconds(5));
 
+// The cache must outlive the returned future.
+std::future<std::string> queryMotdAsync(std::string_view host, uint16_t port, RttCache& rtt);
+
 void queryMotdAsync(
     std::string_view                           host,
     uint16_t                                   port,
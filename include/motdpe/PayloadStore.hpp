@@ -0,0 +1,98 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/SinkWriter.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace motdpe {
+
+namespace detail {
+class PayloadStoreImpl;
+}
+
+// Content address of a raw pong payload: its 128-bit XXH3 hash. The all-zero id stands for "no payload".
+struct PayloadId {
+    uint64_t low  = 0;
+    uint64_t high = 0;
+
+    // 32 lowercase hex digits, high half first, as xxhsum prints XXH128.
+    [[nodiscard]] std::string toString() const;
+    // Parses the form written by toString().
+    [[nodiscard]] static std::optional<PayloadId> parse(std::string_view text) noexcept;
+
+    explicit operator bool() const noexcept { return (low | high) != 0; }
+
+    bool operator==(const PayloadId&) const noexcept = default;
+};
+
+struct PayloadIdHash {
+    // The id is already a uniform hash.
+    size_t operator()(const PayloadId& id) const noexcept { return static_cast<size_t>(id.low); }
+};
+
+struct PayloadStoreStats {
+    // Distinct payloads held and their total size.
+    size_t   payloads = 0;
+    uint64_t bytes    = 0;
+    // Calls to intern() and how many of them found the payload already stored.
+    uint64_t interned = 0;
+    uint64_t hits     = 0;
+    // Bytes passed to intern(); against `bytes`, the saving from deduplication.
+    uint64_t internedBytes = 0;
+    // Payloads stored under a probed id because a different payload held their hash, and log writes that failed.
+    uint64_t collisions = 0;
+    uint64_t logErrors  = 0;
+};
+
+// Deduplicated storage for raw pong payloads. Servers answer with the same bytes probe after probe, so history and
+// result sinks can record a 16-byte PayloadId per observation and keep each distinct payload once. Interning a payload
+// that is already stored costs a hash, a lookup and a comparison under a shared lock; only new payloads are copied.
+//
+// Thread-safe. A MonitorOptions::payloads or ScanOptions::payloads store is filled from the scheduler or scan thread
+// while other threads look payloads up.
+class PayloadStore {
+public:
+    PayloadStore();
+    // Also appends every payload on first sight to `log` as a {"id", "payload"} JSON line, so a history that records
+    // ids stays resolvable after a restart. The log is append-only: a payload erased and interned again is written
+    // again, which readers resolve by keeping the first line per id. Write errors are counted in
+    // PayloadStoreStats::logErrors instead of being thrown from intern().
+    explicit PayloadStore(std::shared_ptr<SinkWriter> log);
+    ~PayloadStore();
+
+    PayloadStore(const PayloadStore&)            = delete;
+    PayloadStore& operator=(const PayloadStore&) = delete;
+
+    [[nodiscard]] static PayloadId hash(std::string_view payload) noexcept;
+
+    // Stores the payload unless it is already present and returns its id. A payload whose hash is taken by a different
+    // one, which takes a deliberate XXH3 collision, is stored under the next free id instead, so it is still kept
+    // apart; such an id depends on what the store held and is not reproducible elsewhere.
+    PayloadId intern(std::string_view payload);
+
+    // The stored payload; the view stays valid until the payload is erased.
+    [[nodiscard]] std::optional<std::string_view> find(const PayloadId& id) const;
+    [[nodiscard]] bool                            contains(const PayloadId& id) const;
+
+    // Drops one payload; ids recorded elsewhere no longer resolve.
+    bool erase(const PayloadId& id);
+    void clear();
+
+    [[nodiscard]] size_t            size() const;
+    [[nodiscard]] PayloadStoreStats stats() const;
+
+private:
+    std::unique_ptr<detail::PayloadStoreImpl> mImpl;
+};
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,71 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Batch.hpp"
+#include "motdpe/Endpoint.hpp"
+#include "motdpe/QueryChannel.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace motdpe {
+
+namespace detail {
+
+class PingContextImpl;
+
+// Type-erased operation submitted to a PingContext. The operation's storage is owned by the submitter and must stay
+// valid until `complete` has been called. The context links queued and outstanding operations through them, so
+// submitting allocates nothing.
+struct PingOperationBase {
+    // `result` is null when the operation was cancelled.
+    using Complete = void (*)(PingOperationBase& operation, const BatchResult* result) noexcept;
+
+    Endpoint                  endpoint;
+    std::chrono::milliseconds timeout{0};
+    Complete                  complete = nullptr;
+    // False for an operation that only moves onto the context's thread; it completes with an empty result there.
+    bool              ping = true;
+    std::atomic<bool> cancelRequested{false};
+
+    // Owned by the context between submit() and completion.
+    PingOperationBase* prev  = nullptr;
+    PingOperationBase* next  = nullptr;
+    uint64_t           query = 0;
+};
+
+} // namespace detail
+
+// I/O thread driving a QueryChannel for operations submitted from any thread. Every completion runs on that thread.
+class PingContext {
+public:
+    // Throws if an explicit source cannot be bound.
+    explicit PingContext(const ChannelOptions& options = {});
+    // Stops the thread; operations still outstanding complete as cancelled, as do operations submitted from those
+    // completions.
+    ~PingContext();
+
+    PingContext(const PingContext&)            = delete;
+    PingContext& operator=(const PingContext&) = delete;
+
+    [[nodiscard]] std::chrono::milliseconds defaultTimeout() const noexcept { return mDefaultTimeout; }
+
+    // Queues an operation. Thread-safe.
+    void submit(detail::PingOperationBase& operation);
+    // Makes the operation complete as cancelled unless it already completed; a request that races ahead of submit()
+    // takes effect when the operation starts. The operation must still be valid, which holds in a stop callback that
+    // its completion destroys first. Thread-safe.
+    void cancel(detail::PingOperationBase& operation);
+
+private:
+    std::unique_ptr<detail::PingContextImpl> mImpl;
+    std::chrono::milliseconds                mDefaultTimeout;
+};
+
+} // namespace motdpe
\ No newline at end of file
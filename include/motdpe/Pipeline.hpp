@@ -0,0 +1,113 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Endpoint.hpp"
+#include "motdpe/Enrichment.hpp"
+#include "motdpe/Pong.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace motdpe {
+
+namespace detail {
+struct PipelineStage;
+}
+
+// Unit of work flowing through a pipeline. Stock stages fill the fields in order and pass items carrying an error
+// through untouched, so the sink sees failures as well.
+struct PipelineItem {
+    std::string               host;
+    uint16_t                  port = 19132;
+    std::optional<Endpoint>   endpoint;
+    std::string               motd;
+    std::chrono::microseconds rtt{0};
+    std::optional<Pong>       pong;
+    std::optional<Enrichment> enrichment;
+    std::string               error;
+};
+
+struct StageOptions {
+    std::string name;
+    size_t      threads = 1;
+    // Capacity of the queue feeding this stage; a full queue blocks the upstream stage.
+    size_t queueCapacity = 1024;
+};
+
+struct StageStats {
+    std::string name;
+    size_t      threads   = 0;
+    uint64_t    processed = 0;
+    uint64_t    dropped   = 0;
+    size_t      queued    = 0;
+    size_t      capacity  = 0;
+    // Fraction of the stage's thread time spent inside the stage function.
+    double utilization = 0.0;
+    // Fraction of the stage's thread time spent waiting for room downstream.
+    double blocked = 0.0;
+};
+
+// Chain of stages, each running on its own threads and connected by bounded lock-free queues. Back-pressure flows
+// upstream: a stage that cannot hand items on stops taking new ones until push() itself blocks.
+class Pipeline {
+public:
+    // Returns false to drop the item. Exceptions are recorded in `item.error` and the item continues.
+    using StageFunction = std::function<bool(PipelineItem&)>;
+
+    Pipeline();
+    ~Pipeline();
+
+    Pipeline(const Pipeline&)            = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    // Appends a stage; only valid before start().
+    Pipeline& addStage(StageOptions options, StageFunction function);
+
+    void start();
+
+    // Blocks while the first stage's queue is full.
+    void push(PipelineItem item);
+    // Leaves `item` untouched and returns false when the first stage's queue is full.
+    bool tryPush(PipelineItem& item);
+
+    // Stops accepting input, drains every stage and joins the threads.
+    void close();
+
+    [[nodiscard]] std::vector<StageStats> stats() const;
+
+private:
+    std::vector<std::unique_ptr<detail::PipelineStage>> mStages;
+    std::chrono::steady_clock::time_point               mStarted{};
+    bool                                                mRunning = false;
+};
+
+namespace stages {
+
+// host/port -> endpoint (first resolved address).
+Pipeline::StageFunction resolve();
+
+// endpoint -> motd, rtt.
+Pipeline::StageFunction ping(std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
+// motd -> pong; drops items whose payload does not parse when `dropInvalid` is set.
+Pipeline::StageFunction parse(bool dropInvalid = false);
+
+// endpoint -> enrichment, for items that answered the ping.
+Pipeline::StageFunction enrich(EnrichmentOptions options = {});
+
+// Hands every item to `sink`.
+Pipeline::StageFunction sink(std::function<void(const PipelineItem&)> sink);
+
+} // namespace stages
+
+} // namespace motdpe
\ No newline at end of file
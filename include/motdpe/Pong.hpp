@@ -0,0 +1,52 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace motdpe {
+
+// Fields of the semicolon-separated server id string carried in an unconnected pong, e.g.
+// "MCPE;Dedicated Server;712;1.21.0;3;20;1234567890;Bedrock level;Survival;1;19132;19133;".
+struct Pong {
+    std::string edition;
+    std::string motd;
+    int32_t     protocol = 0;
+    std::string version;
+    int32_t     online = 0;
+    int32_t     max    = 0;
+    std::string serverId;
+    std::string subMotd;
+    std::string gameMode;
+    int32_t     gameModeId = -1;
+    uint16_t    portV4     = 0;
+    uint16_t    portV6     = 0;
+
+    bool operator==(const Pong&) const = default;
+};
+
+// Nothing unless at least edition, MOTD, protocol, version and player counts are present. Malformed numeric fields
+// keep their defaults.
+std::optional<Pong> parsePong(std::string_view payload);
+
+// Unconnected ping datagram for callers running their own sockets. Servers echo `timestamp` back in the pong.
+std::array<std::byte, 33> makePingPacket(uint64_t timestamp) noexcept;
+
+// Server id string of an unconnected pong datagram, viewing into `packet`; nothing if it is not one. `timestamp`
+// receives the echoed ping timestamp when given.
+std::optional<std::string_view> pongPayload(std::span<const std::byte> packet, uint64_t* timestamp = nullptr) noexcept;
+
+// Removes Minecraft formatting codes ("§" followed by one character).
+std::string stripFormatting(std::string_view text);
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,100 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Batch.hpp"
+#include "motdpe/Endpoint.hpp"
+#include "motdpe/RateController.hpp"
+#include "motdpe/Transport.hpp"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace motdpe {
+
+namespace detail {
+class PingEngine;
+}
+
+#ifdef _WIN32
+using NativeSocket = uintptr_t;
+#else
+using NativeSocket = int;
+#endif
+
+struct ChannelOptions {
+    // Default per-query timeout, counted from the call to query().
+    std::chrono::milliseconds timeout = std::chrono::seconds(5);
+    // Send pacing per source.
+    RateControllerOptions rate{};
+    TransportOptions      transport{};
+};
+
+// Query driver for an application-owned event loop, in the style of c-ares: it never blocks, never starts threads and
+// takes no locks. Register sockets() for readability, wake up no later than nextTimeout(), and call process() when
+// either fires. Callbacks run inside process(). Not thread-safe; use it from the loop's thread only.
+class QueryChannel {
+public:
+    using Clock    = std::chrono::steady_clock;
+    using Callback = std::function<void(const BatchResult&)>;
+
+    // Throws if an explicit source cannot be bound.
+    explicit QueryChannel(const ChannelOptions& options = {});
+    ~QueryChannel();
+
+    QueryChannel(const QueryChannel&)            = delete;
+    QueryChannel& operator=(const QueryChannel&) = delete;
+
+    // Queues a ping to a resolved endpoint and sends it right away when the rate allows. Returns an id for cancel().
+    uint64_t query(const Endpoint& endpoint, Callback callback);
+    uint64_t query(const Endpoint& endpoint, std::chrono::milliseconds timeout, Callback callback);
+
+    // Drops a query without invoking its callback; false if it already completed.
+    bool cancel(uint64_t id);
+
+    // Sockets to watch for readability; fixed for the lifetime of the channel.
+    [[nodiscard]] std::vector<NativeSocket> sockets() const;
+
+    // Latest time at which process() must run even without readable sockets; nothing while idle.
+    [[nodiscard]] std::optional<Clock::time_point> nextTimeout();
+
+    // Reads pongs if any of the channel's sockets is in `readable`, expires overdue queries and sends queued ones.
+    void process(std::span<const NativeSocket> readable, Clock::time_point now = Clock::now());
+
+    // Queries that have not completed yet.
+    [[nodiscard]] size_t pending() const noexcept { return mQueued.size() + mInFlight.size() + mFailed.size(); }
+
+private:
+    struct Query {
+        uint64_t          id;
+        Endpoint          endpoint;
+        Clock::time_point deadline;
+        Callback          callback;
+    };
+
+    // Sends queued queries until the rate limit or socket buffer pushes back.
+    void flush(Clock::time_point now);
+
+    ChannelOptions                             mOptions;
+    std::unique_ptr<detail::PingEngine>        mEngine;
+    std::vector<NativeSocket>                  mSockets;
+    std::deque<Query>                          mQueued;
+    std::unordered_map<uint64_t, Query>        mInFlight;
+    std::vector<std::pair<Query, BatchResult>> mFailed;
+    // When a flush stopped early, the time worth retrying it.
+    std::optional<Clock::time_point> mRetryAt;
+    uint64_t                         mNextId = 1;
+};
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,60 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Endpoint.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+namespace motdpe {
+
+namespace detail {
+class Poptrie;
+}
+
+enum class RangeAction : uint8_t {
+    None,
+    Allow,
+    Exclude,
+};
+
+// Allow/exclude list of IPv4 and IPv6 prefixes compiled into compressed prefix tries. The most specific matching
+// prefix decides, so an allow entry can carve a hole into a broader exclusion and vice versa. Once any allow entry
+// exists, addresses matching no prefix at all are rejected.
+class RangeFilter {
+public:
+    RangeFilter();
+    ~RangeFilter();
+
+    RangeFilter(RangeFilter&&) noexcept;
+    RangeFilter& operator=(RangeFilter&&) noexcept;
+
+    // Stages a prefix such as "10.0.0.0/8" or "2001:db8::/32"; takes effect on the next build(). Throws on malformed
+    // input.
+    void add(std::string_view cidr, RangeAction action);
+
+    // Reads one prefix per line, optionally preceded by "allow" or "exclude"; bare prefixes use `defaultAction`.
+    // Blank lines and text after '#' are ignored. Builds the filter when done. Throws on I/O or parse errors.
+    void loadFile(const std::filesystem::path& path, RangeAction defaultAction = RangeAction::Exclude);
+
+    // Compiles the staged prefixes into the lookup structure.
+    void build();
+
+    [[nodiscard]] RangeAction lookup(const Endpoint& endpoint) const noexcept;
+    [[nodiscard]] bool        permits(const Endpoint& endpoint) const noexcept;
+
+    [[nodiscard]] size_t size() const noexcept;
+
+private:
+    std::unique_ptr<detail::Poptrie> mV4;
+    std::unique_ptr<detail::Poptrie> mV6;
+    bool                             mHasAllow = false;
+};
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,92 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+namespace motdpe {
+
+struct RateControllerOptions {
+    // Pings per second.
+    double initialRate = 1000.0;
+    double minRate     = 50.0;
+    double maxRate     = 100000.0;
+    // Added to the rate after every window without a congestion signal.
+    double additiveIncrease = 250.0;
+    // Applied to the rate when a window shows loss or RTT inflation.
+    double multiplicativeDecrease = 0.5;
+    // Length of one measurement window.
+    std::chrono::milliseconds window = std::chrono::milliseconds(250);
+    // The response ratio is measured over this many most recent windows.
+    uint32_t lossWindows = 8;
+    // Fewer resolved pings than this across those windows carry no loss signal.
+    uint32_t minSamples = 32;
+    // A window is lossy when its response ratio drops below (1 - lossTolerance) of the baseline ratio.
+    double lossTolerance = 0.2;
+    // A window is congested when its mean RTT exceeds the minimum RTT by this factor.
+    double rttInflation = 2.0;
+    // Number of windows over which the minimum RTT is tracked.
+    uint32_t baseRttWindows = 40;
+    // Pings sent before a decrease resolve up to one timeout later; their outcome is ignored for this long.
+    std::chrono::milliseconds decreaseHold = std::chrono::seconds(1);
+    // Token bucket depth, expressed as time at the current rate.
+    std::chrono::milliseconds burst = std::chrono::milliseconds(5);
+};
+
+// Closed-loop AIMD send-rate controller. The response ratio of resolved pings is tracked over a sliding set of
+// windows and the RTT per window; clean windows raise the rate additively, lossy or RTT-inflated ones cut it
+// multiplicatively.
+class RateController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RateController() : RateController(RateControllerOptions{}) {}
+    // Throws unless window > 0, 0 < minRate <= maxRate and 0 < multiplicativeDecrease < 1.
+    explicit RateController(const RateControllerOptions& options, Clock::time_point now = Clock::now());
+
+    // Number of pings (at most `wanted`) that may be sent now; the caller must send exactly that many.
+    [[nodiscard]] size_t acquire(Clock::time_point now, size_t wanted);
+    // Earliest time at which `acquire` will grant another ping.
+    [[nodiscard]] Clock::time_point nextSendTime() const noexcept;
+
+    void onResponse(std::chrono::microseconds rtt, Clock::time_point now);
+    void onTimeout(Clock::time_point now);
+
+    // Externally imposed congestion signal (e.g. a saturated consumer).
+    void onCongestion(Clock::time_point now);
+
+    [[nodiscard]] double rate() const noexcept { return mRate; }
+    [[nodiscard]] double baselineRatio() const noexcept { return mBaselineRatio; }
+    [[nodiscard]] std::chrono::microseconds baseRtt() const noexcept;
+
+private:
+    void advance(Clock::time_point now);
+    void closeWindow(Clock::time_point now);
+    void decrease(Clock::time_point now);
+
+    RateControllerOptions mOptions;
+    double                mRate;
+    double                mTokens = 1.0;
+    Clock::time_point     mLastRefill;
+    Clock::time_point     mWindowEnd;
+    Clock::time_point     mHoldUntil{};
+
+    uint64_t mWindowResponses = 0;
+    uint64_t mWindowTimeouts  = 0;
+    int64_t  mWindowRttSum    = 0;
+
+    double                                     mBaselineRatio = -1.0;
+    std::deque<std::pair<uint64_t, uint64_t>> mHistory;
+    std::deque<int64_t>                        mWindowMinRtts;
+    int64_t                                    mWindowMinRtt = INT64_MAX;
+};
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,101 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace motdpe {
+
+struct RttOptions {
+    // Timeout used before the first sample arrives. Also the upper bound for any derived timeout.
+    std::chrono::milliseconds maxTimeout = std::chrono::seconds(5);
+    // Hedged retransmit delay used before the first sample arrives.
+    std::chrono::milliseconds initialHedge = std::chrono::seconds(1);
+    // Lower bound for the retransmission timeout (RTO).
+    std::chrono::milliseconds minRto = std::chrono::milliseconds(10);
+    // The query is abandoned after this many RTOs without a pong.
+    uint32_t timeoutRtoCount = 3;
+};
+
+// Smoothed RTT estimator for a single endpoint, following the TCP retransmission timer (RFC 6298).
+class RttEstimator {
+public:
+    RttEstimator() = default;
+    explicit RttEstimator(const RttOptions& options) noexcept : mOptions(options) {}
+
+    void addSample(std::chrono::microseconds rtt) noexcept;
+    void onTimeout() noexcept;
+    // Reinstates state previously read through srtt(), rttvar() and backoff(); a zero SRTT means no sample.
+    void restore(std::chrono::microseconds srtt, std::chrono::microseconds rttvar, uint32_t backoff) noexcept;
+
+    [[nodiscard]] bool                      hasSample() const noexcept { return mHasSample; }
+    [[nodiscard]] std::chrono::microseconds srtt() const noexcept { return mSrtt; }
+    [[nodiscard]] std::chrono::microseconds rttvar() const noexcept { return mRttvar; }
+    [[nodiscard]] uint32_t                  backoff() const noexcept { return mBackoff; }
+
+    // Retransmission timeout: SRTT + 4 * RTTVAR, clamped to the configured bounds and backed off after timeouts.
+    [[nodiscard]] std::chrono::microseconds rto() const noexcept;
+    // Delay after which a duplicate ping is sent while still waiting for the first pong.
+    [[nodiscard]] std::chrono::milliseconds hedgeDelay() const noexcept;
+    // Total time to wait for a pong before giving up.
+    [[nodiscard]] std::chrono::milliseconds timeout() const noexcept;
+
+private:
+    RttOptions                mOptions{};
+    std::chrono::microseconds mSrtt{0};
+    std::chrono::microseconds mRttvar{0};
+    uint32_t                  mBackoff   = 0;
+    bool                      mHasSample = false;
+};
+
+// Thread-safe table of RTT estimators keyed by "host:port". Holds at most `capacity` endpoints; recording a sample or
+// timeout for a new endpoint beyond that evicts the least recently updated one.
+class RttCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    RttCache() = default;
+    explicit RttCache(const RttOptions& options, size_t capacity = DEFAULT_CAPACITY)
+    : mOptions(options),
+      mCapacity(capacity == 0 ? 1 : capacity) {}
+
+    RttCache(const RttCache&)            = delete;
+    RttCache& operator=(const RttCache&) = delete;
+
+    [[nodiscard]] RttEstimator get(std::string_view host, uint16_t port) const;
+
+    void addSample(std::string_view host, uint16_t port, std::chrono::microseconds rtt);
+    void onTimeout(std::string_view host, uint16_t port);
+    void erase(std::string_view host, uint16_t port);
+    void clear();
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t capacity() const noexcept { return mCapacity; }
+
+private:
+    struct Entry {
+        std::string  key;
+        RttEstimator estimator;
+    };
+
+    RttEstimator& at(std::string_view key);
+
+    RttOptions                                                       mOptions{};
+    size_t                                                           mCapacity = DEFAULT_CAPACITY;
+    mutable std::mutex                                               mMutex;
+    // Most recently updated first. Index keys view the strings owned by the list nodes, which never move.
+    std::list<Entry>                                                 mEntries;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> mIndex;
+};
+
+} // namespace motdpe
\ No newline at end of file
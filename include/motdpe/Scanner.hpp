@@ -0,0 +1,190 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/BloomFilter.hpp"
+#include "motdpe/Endpoint.hpp"
+#include "motdpe/Enrichment.hpp"
+#include "motdpe/PayloadStore.hpp"
+#include "motdpe/RangeFilter.hpp"
+#include "motdpe/RateController.hpp"
+#include "motdpe/SinkWriter.hpp"
+#include "motdpe/Transport.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace motdpe {
+
+namespace detail {
+class EnrichmentStage;
+}
+
+enum class DedupeKey : uint8_t {
+    Endpoint,
+    // Server id advertised in the pong, so one server answering on several addresses or ports is reported once.
+    // Pongs without one fall back to the endpoint.
+    ServerId,
+};
+
+struct ScanOptions {
+    std::vector<uint16_t>     ports{19132};
+    std::chrono::milliseconds timeout = std::chrono::seconds(2);
+    // Send pacing per source.
+    RateControllerOptions rate{};
+    TransportOptions      transport{};
+    // Seed of the target permutation; 0 picks a random one.
+    uint64_t seed = 0;
+    // Targets the filter does not permit are skipped without consuming send budget.
+    std::shared_ptr<const RangeFilter> filter;
+    // Hits whose key is already in the filter are counted as duplicates and are neither reported nor enriched. Share
+    // one filter between scans over overlapping inputs; it must not be used by two scans at the same time.
+    std::shared_ptr<BloomFilter> seen;
+    DedupeKey                    dedupeBy = DedupeKey::Endpoint;
+    // Reported hits are appended as JSON lines ({"address", "port", "rtt_us", "motd"}) and written by the sink's own
+    // thread. While the sink is saturated, new pings pause and the send rate is cut as on congestion, so a slow disk
+    // slows the scan down instead of stalling pong processing.
+    std::shared_ptr<SinkWriter> sink;
+    // Hit payloads are interned here, and sink lines carry "payload" (the PayloadId) instead of "motd".
+    std::shared_ptr<PayloadStore> payloads;
+};
+
+struct ScanHit {
+    Endpoint                  endpoint;
+    // Raw pong payload; empty when ScanOptions::payloads is set, which holds it under `payload` instead.
+    std::string               motd;
+    std::chrono::microseconds rtt{0};
+    // Id of the pong payload in ScanOptions::payloads, resolved with `payloads->find(payload)`; zero without a store.
+    PayloadId                 payload;
+};
+
+struct ScanStats {
+    uint64_t                  targets  = 0;
+    uint64_t                  sent     = 0;
+    uint64_t                  hits     = 0;
+    uint64_t                  timeouts = 0;
+    uint64_t                  filtered = 0;
+    uint64_t                  enriched = 0;
+    // Hits reported but not enriched because the enrichment queue was full.
+    uint64_t                  unenriched = 0;
+    // Hits suppressed by `ScanOptions::seen`; included in `hits`.
+    uint64_t                  duplicates = 0;
+    // Aggregate send rate at the end of the scan.
+    double                    rate = 0.0;
+    std::chrono::milliseconds elapsed{0};
+    std::vector<SourceStats>  sources;
+};
+
+struct EstimateOptions {
+    // Two-sided confidence level of the interval.
+    double confidence = 0.95;
+    // Stop once the interval's half-width is within this fraction of the estimate.
+    double relativeError = 0.1;
+    // Hits required before the interval is trusted.
+    uint64_t minHits = 30;
+    // Upper bound on drawn targets; 0 means the whole space.
+    uint64_t maxSamples = 0;
+};
+
+struct PopulationEstimate {
+    // Expected number of responding (address, port) pairs in the scan space.
+    double   estimate = 0.0;
+    double   lower    = 0.0;
+    double   upper    = 0.0;
+    uint64_t sampled  = 0;
+    uint64_t hits     = 0;
+    // False when the space or `maxSamples` was exhausted before reaching the requested precision.
+    bool      converged = false;
+    ScanStats stats;
+};
+
+struct RescanOptions {
+    // Addresses on either side of a previous hit, within the same scan range and port, that are pinged first.
+    uint32_t neighborRadius = 4;
+    // Fraction of the full scan space revisited after the prioritized targets.
+    double backgroundFraction = 0.05;
+    // Permutation index where the background slice starts; advancing it by the slice length on every rescan with a
+    // fixed `ScanOptions::seed` walks the whole space over successive rescans.
+    uint64_t backgroundStart = 0;
+};
+
+// Discovery sweep over address ranges. Every (address, port) pair is visited once in a keyed pseudo-random order so
+// that consecutive pings spread across networks, and the send rate is driven by a loss-aware AIMD controller.
+class Scanner {
+public:
+    using HitCallback      = std::function<void(const ScanHit&)>;
+    using EnrichedCallback = std::function<void(const ScanHit&, const Enrichment&)>;
+
+    Scanner() : Scanner(ScanOptions{}) {}
+    explicit Scanner(ScanOptions options) : mOptions(std::move(options)) {}
+
+    // Accepts "a.b.c.d/len", "v6addr/len" (at most 32 host bits) or a single address; throws on malformed input.
+    void addRange(std::string_view cidr);
+
+    // Number of (address, port) pairs in the scan.
+    [[nodiscard]] uint64_t size() const noexcept;
+
+    ScanStats run(const HitCallback& onHit);
+
+    // Two-phase discovery: hits stream into a bounded enrichment stage running `enrichment.concurrency` follow-ups at
+    // a time while the sweep continues; new pings pause while the stage's queue is full, and hits that arrive then
+    // skip enrichment. `onEnriched` calls are serialized; the first exception it throws is rethrown once the scan has
+    // drained.
+    ScanStats run(
+        const EnrichmentOptions& enrichment,
+        const EnrichedCallback&  onEnriched,
+        const HitCallback&       onHit = {}
+    );
+
+    // Sampling mode: pings a prefix of the random permutation, which is a uniform sample without replacement, and
+    // stops sending once the Wilson interval of the hit count reaches the requested precision.
+    PopulationEstimate estimate(const EstimateOptions& options = {}, const HitCallback& onHit = {});
+
+    // Incremental refresh: pings `previousHits` and their neighbours first, then a random slice of the rest of the
+    // space. Previous hits outside the scan ranges are dropped.
+    ScanStats rescan(
+        std::span<const Endpoint> previousHits,
+        const RescanOptions&      options = {},
+        const HitCallback&        onHit   = {}
+    );
+
+private:
+    struct Range {
+        Endpoint base;
+        uint64_t count;
+    };
+
+    [[nodiscard]] Endpoint                addressAt(uint64_t address) const;
+    [[nodiscard]] Endpoint                targetAt(uint64_t index) const;
+    [[nodiscard]] std::optional<uint64_t> addressIndexOf(const Endpoint& endpoint) const noexcept;
+
+    // Target for a draw index; nothing skips the draw.
+    using TargetSource  = std::function<std::optional<Endpoint>(uint64_t)>;
+    using StopPredicate = std::function<bool(const ScanStats&)>;
+
+    [[nodiscard]] TargetSource permutedTargets() const;
+
+    ScanStats runImpl(
+        uint64_t                 targets,
+        const TargetSource&      targetFor,
+        const HitCallback&       onHit,
+        detail::EnrichmentStage* stage,
+        const StopPredicate&     stopSending
+    );
+
+    ScanOptions           mOptions;
+    std::vector<Range>    mRanges;
+    std::vector<uint64_t> mRangeEnds;
+};
+
+} // namespace motdpe
\ No newline at end of file
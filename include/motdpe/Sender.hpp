@@ -0,0 +1,214 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+// Optional sender/receiver (P2300) interface on top of stdexec; only translation units that include this header need
+// stdexec.
+
+#pragma once
+#include "motdpe/PingContext.hpp"
+#include <chrono>
+#include <concepts>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <stdexec/execution.hpp>
+#include <string>
+#include <utility>
+
+namespace motdpe {
+
+class PingScheduler;
+
+namespace detail {
+
+// Operation state of a ping sender. It lives wherever the receiver's owner connects it (typically on the caller's
+// stack or inside an enclosing operation state), and the context links it into its own lists while it is
+// outstanding, so starting a ping allocates nothing.
+template <typename Receiver>
+class PingOperation : private PingOperationBase {
+public:
+    using operation_state_concept = stdexec::operation_state_t;
+
+    PingOperation(PingContext& context, const Endpoint& target, std::chrono::milliseconds wait, Receiver receiver)
+    : mContext(context),
+      mReceiver(std::move(receiver)) {
+        endpoint = target;
+        timeout  = wait;
+        complete = &PingOperation::onComplete;
+    }
+
+    PingOperation(PingOperation&&) = delete;
+
+    void start() & noexcept {
+        auto token = stdexec::get_stop_token(stdexec::get_env(mReceiver));
+        if (token.stop_requested()) {
+            stdexec::set_stopped(std::move(mReceiver));
+            return;
+        }
+        // The callback must exist before the context can complete the operation, which resets it.
+        mStopCallback.emplace(token, StopRequest{this});
+        mContext.submit(*this);
+    }
+
+private:
+    struct StopRequest {
+        PingOperation* self;
+
+        // Resetting the callback in onComplete waits for a running one, so the operation is still valid here.
+        void operator()() const noexcept { self->mContext.cancel(*self); }
+    };
+
+    using StopToken    = stdexec::stop_token_of_t<stdexec::env_of_t<Receiver>>;
+    using StopCallback = stdexec::stop_callback_for_t<StopToken, StopRequest>;
+
+    static void onComplete(PingOperationBase& base, const BatchResult* result) noexcept {
+        auto& self = static_cast<PingOperation&>(base);
+        self.mStopCallback.reset();
+        if (!result) {
+            stdexec::set_stopped(std::move(self.mReceiver));
+        } else if (result->motd) {
+            try {
+                stdexec::set_value(std::move(self.mReceiver), std::string{*result->motd});
+            } catch (...) {
+                stdexec::set_error(std::move(self.mReceiver), std::current_exception());
+            }
+        } else {
+            stdexec::set_error(
+                std::move(self.mReceiver),
+                std::make_exception_ptr(std::runtime_error{result->error})
+            );
+        }
+    }
+
+    PingContext&                mContext;
+    Receiver                    mReceiver;
+    std::optional<StopCallback> mStopCallback;
+};
+
+// Operation state of PingScheduler::schedule(): a hop onto the context's I/O thread.
+template <typename Receiver>
+class ScheduleOperation : private PingOperationBase {
+public:
+    using operation_state_concept = stdexec::operation_state_t;
+
+    ScheduleOperation(PingContext& context, Receiver receiver) : mContext(context), mReceiver(std::move(receiver)) {
+        ping     = false;
+        complete = &ScheduleOperation::onComplete;
+    }
+
+    ScheduleOperation(ScheduleOperation&&) = delete;
+
+    void start() & noexcept { mContext.submit(*this); }
+
+private:
+    static void onComplete(PingOperationBase& base, const BatchResult* result) noexcept {
+        auto& self = static_cast<ScheduleOperation&>(base);
+        if (!result || stdexec::get_stop_token(stdexec::get_env(self.mReceiver)).stop_requested()) {
+            stdexec::set_stopped(std::move(self.mReceiver));
+        } else {
+            stdexec::set_value(std::move(self.mReceiver));
+        }
+    }
+
+    PingContext& mContext;
+    Receiver     mReceiver;
+};
+
+// Environment of the senders below: the listed completions happen on the context's I/O thread.
+template <typename... Completions>
+struct PingEnv {
+    PingContext* context;
+
+    template <typename Completion>
+        requires(std::same_as<Completion, Completions> || ...)
+    [[nodiscard]] PingScheduler query(stdexec::get_completion_scheduler_t<Completion>) const noexcept;
+};
+
+} // namespace detail
+
+// Scheduler on a context's I/O thread, for stdexec::continues_on and friends. Work continued onto it delays every
+// query on the context, so keep it short. Schedule operations complete with set_stopped once the context shuts down.
+class PingScheduler {
+public:
+    class Sender {
+    public:
+        using sender_concept        = stdexec::sender_t;
+        using completion_signatures = stdexec::completion_signatures<stdexec::set_value_t(), stdexec::set_stopped_t()>;
+
+        explicit Sender(PingContext& context) noexcept : mContext(&context) {}
+
+        template <stdexec::receiver_of<completion_signatures> Receiver>
+        detail::ScheduleOperation<Receiver> connect(Receiver receiver) const {
+            return detail::ScheduleOperation<Receiver>{*mContext, std::move(receiver)};
+        }
+
+        [[nodiscard]] detail::PingEnv<stdexec::set_value_t> get_env() const noexcept { return {mContext}; }
+
+    private:
+        PingContext* mContext;
+    };
+
+    explicit PingScheduler(PingContext& context) noexcept : mContext(&context) {}
+
+    [[nodiscard]] Sender schedule() const noexcept { return Sender{*mContext}; }
+
+    bool operator==(const PingScheduler&) const noexcept = default;
+
+private:
+    PingContext* mContext;
+};
+
+template <typename... Completions>
+template <typename Completion>
+    requires(std::same_as<Completion, Completions> || ...)
+PingScheduler detail::PingEnv<Completions...>::query(stdexec::get_completion_scheduler_t<Completion>) const noexcept {
+    return PingScheduler{*context};
+}
+
+// Sender of a single MOTD query. Completes on the context's I/O thread, which its environment reports as the
+// completion scheduler, with set_value(std::string) or set_error with a std::exception_ptr on timeout or send failure;
+// set_stopped when the receiver's stop token fires first. Batches compose with stdexec::when_all without intermediate
+// futures.
+class PingSender {
+public:
+    using sender_concept        = stdexec::sender_t;
+    using completion_signatures = stdexec::completion_signatures<
+        stdexec::set_value_t(std::string),
+        stdexec::set_error_t(std::exception_ptr),
+        stdexec::set_stopped_t()>;
+
+    PingSender(PingContext& context, const Endpoint& endpoint, std::chrono::milliseconds timeout) noexcept
+    : mContext(&context),
+      mEndpoint(endpoint),
+      mTimeout(timeout) {}
+
+    template <stdexec::receiver_of<completion_signatures> Receiver>
+    detail::PingOperation<Receiver> connect(Receiver receiver) const {
+        return detail::PingOperation<Receiver>{*mContext, mEndpoint, mTimeout, std::move(receiver)};
+    }
+
+    [[nodiscard]] detail::PingEnv<stdexec::set_value_t, stdexec::set_error_t> get_env() const noexcept {
+        return {mContext};
+    }
+
+private:
+    PingContext*              mContext;
+    Endpoint                  mEndpoint;
+    std::chrono::milliseconds mTimeout;
+};
+
+inline PingScheduler pingScheduler(PingContext& context) noexcept { return PingScheduler{context}; }
+
+inline PingSender pingSender(PingContext& context, const Endpoint& endpoint, std::chrono::milliseconds timeout) {
+    return PingSender{context, endpoint, timeout};
+}
+
+inline PingSender pingSender(PingContext& context, const Endpoint& endpoint) {
+    return PingSender{context, endpoint, context.defaultTimeout()};
+}
+
+} // namespace motdpe
\ No newline at end of file
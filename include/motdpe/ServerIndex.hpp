@@ -0,0 +1,91 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Pong.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace motdpe {
+
+namespace detail {
+class ServerIndexImpl;
+}
+
+enum class ServerOrder : uint8_t {
+    Players,
+    MaxPlayers,
+};
+
+// Filter and sort order of a server list query; unset attributes match every server. For example
+// {.edition = "MCPE", .protocol = 712, .freeSlots = true} lists MCPE servers on protocol 712 with free slots, most
+// players first.
+struct ServerQuery {
+    std::optional<std::string> edition;
+    std::optional<std::string> version;
+    std::optional<std::string> gameMode;
+    std::optional<int32_t>     protocol;
+    // Inclusive range of online players.
+    int32_t minPlayers = std::numeric_limits<int32_t>::min();
+    int32_t maxPlayers = std::numeric_limits<int32_t>::max();
+    // Fewer players online than the server's maximum.
+    bool freeSlots = false;
+    // Also match servers whose last probe failed, by their last known pong.
+    bool        includeDown = false;
+    ServerOrder order       = ServerOrder::Players;
+    bool        ascending   = false;
+    size_t      offset      = 0;
+    size_t      limit       = 50;
+};
+
+struct ServerMatch {
+    uint64_t id;
+    int32_t  online;
+    int32_t  max;
+};
+
+// Secondary indexes over the latest pong of every monitored server: bitmaps over dense row numbers for edition,
+// version, game mode, protocol, free slots and liveness, and ordered indexes on online and maximum players. A query
+// intersects the bitmaps of its filters, then either walks the ordered index until it has `limit` matches or, for
+// selective filters, sorts just the matching rows, so filtered top-N lists over 100k servers take microseconds
+// instead of a scan over every pong.
+//
+// Kept current incrementally: a monitor with this index in MonitorOptions::index queues an update whenever a result
+// changes and applies it on an indexing thread of its own, so queries may trail the latest probe by one scheduler pass.
+// Updates take an exclusive lock for a few set operations; queries share a lock and may run on any number of threads.
+class ServerIndex {
+public:
+    ServerIndex();
+    ~ServerIndex();
+
+    ServerIndex(const ServerIndex&)            = delete;
+    ServerIndex& operator=(const ServerIndex&) = delete;
+
+    // Indexes the pong of a target and marks it up.
+    void update(uint64_t id, const Pong& pong);
+    // Marks an indexed target up or down; its attributes are kept. No-op for targets without a pong.
+    void setUp(uint64_t id, bool up);
+    bool erase(uint64_t id);
+
+    // Matches in query order, skipping `offset` and returning at most `limit`.
+    [[nodiscard]] std::vector<ServerMatch> query(const ServerQuery& query) const;
+    // Total number of matches, ignoring offset and limit.
+    [[nodiscard]] size_t count(const ServerQuery& query) const;
+
+    // Indexed targets, up or down.
+    [[nodiscard]] size_t size() const;
+
+private:
+    std::unique_ptr<detail::ServerIndexImpl> mImpl;
+};
+
+} // namespace motdpe
\ No newline at end of file
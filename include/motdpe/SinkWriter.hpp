@@ -0,0 +1,87 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+namespace motdpe {
+
+namespace detail {
+class SinkThread;
+}
+
+enum class SinkCompression : uint8_t {
+    None,
+    // LZ4 frame format with independent 64 KiB blocks; decompress with `lz4 -d` or any LZ4 library.
+    Lz4,
+};
+
+struct SinkOptions {
+    // Bytes collected before a buffer is handed to the writer thread. Records are never split across buffers.
+    size_t bufferSize = size_t{1} << 20;
+    // Buffers in rotation, at least two. Once all of them wait for the writer, write() blocks.
+    size_t          buffers     = 4;
+    SinkCompression compression = SinkCompression::None;
+    // Bypass the page cache (O_DIRECT on Linux, F_NOCACHE on macOS, FILE_FLAG_NO_BUFFERING on Windows), so a long
+    // scan does not evict everything else from memory. Falls back to buffered writes where the filesystem refuses.
+    bool direct = false;
+};
+
+struct SinkStats {
+    // Bytes passed to write().
+    uint64_t bytesIn = 0;
+    // Bytes that reached the file, after compression.
+    uint64_t bytesOut = 0;
+    // Buffers handed to the writer thread.
+    uint64_t buffers = 0;
+    // Calls to write() that had to wait for a free buffer, and the total time they waited.
+    uint64_t                  stalls = 0;
+    std::chrono::microseconds stalled{0};
+    // Whether the file is written with direct I/O.
+    bool direct = false;
+};
+
+// Append-only file written by a dedicated thread. write() copies into the current buffer and, once it is full, swaps
+// it for an empty one and hands it to the writer thread, which compresses and writes it; callers never wait for the
+// disk unless every buffer is queued. Producers that must not block, such as a scan's receive loop, check saturated()
+// and slow down instead.
+//
+// All members may be called from several threads. Errors from the writer thread are rethrown by the next write(),
+// flush() or close().
+class SinkWriter {
+public:
+    // Creates or truncates the file; throws if it cannot be opened.
+    explicit SinkWriter(const std::filesystem::path& path, const SinkOptions& options = {});
+    // Closes the file, ignoring errors.
+    ~SinkWriter();
+
+    SinkWriter(const SinkWriter&)            = delete;
+    SinkWriter& operator=(const SinkWriter&) = delete;
+
+    void write(std::string_view record);
+
+    // Hands over the current buffer and waits until everything written so far has reached the operating system. With
+    // compression or direct I/O, the tail of the last block is held back until close().
+    void flush();
+
+    // Writes the remaining data and closes the file; further writes throw.
+    void close();
+
+    // True while at least half of the buffers wait for the writer thread.
+    [[nodiscard]] bool      saturated() const noexcept;
+    [[nodiscard]] SinkStats stats() const;
+
+private:
+    std::unique_ptr<detail::SinkThread> mThread;
+};
+
+} // namespace motdpe
\ No newline at end of file
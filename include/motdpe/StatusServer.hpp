@@ -0,0 +1,67 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/StatusTable.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace motdpe {
+
+namespace detail {
+class StatusServerImpl;
+}
+
+struct StatusServerOptions {
+    // Numeric TCP listen address; the default only accepts local clients.
+    std::string host = "127.0.0.1";
+    // 0 picks a free port, see StatusServer::port().
+    uint16_t port = 8080;
+    // Listen on a Unix domain socket at this path instead of TCP (not supported on Windows). A socket file already at
+    // the path is replaced; any other kind of file makes the constructor throw.
+    std::string unixPath;
+    // Further connections are closed right after accept.
+    size_t maxConnections = 256;
+    // Keep-alive connections without a request for this long are closed.
+    std::chrono::milliseconds idleTimeout = std::chrono::seconds(30);
+};
+
+// Embeddable HTTP/1.1 server for the status of monitored targets, read from a StatusTable:
+//
+//   GET /targets       JSON array of every target
+//   GET /targets/<id>  JSON object of one target
+//
+// Responses are rendered once into cached header and body buffers and re-rendered only for targets passed to
+// invalidate(), so serving a request is a single vectored send of cached bytes. A Monitor given the server in
+// MonitorOptions::server invalidates its targets itself. One background thread handles all connections and sleeps in
+// poll() until a client or an invalidation needs it.
+class StatusServer {
+public:
+    // Binds and starts serving; throws if the listen socket cannot be set up.
+    explicit StatusServer(std::shared_ptr<const StatusTable> table, const StatusServerOptions& options = {});
+    ~StatusServer();
+
+    StatusServer(const StatusServer&)            = delete;
+    StatusServer& operator=(const StatusServer&) = delete;
+
+    // Re-renders the response of a target from the table, or drops it once the target is gone. Lock-free and safe
+    // from any thread; only needed for tables written by something other than a Monitor that owns this server.
+    void invalidate(uint64_t id);
+    // Re-renders every response.
+    void invalidateAll();
+
+    // Bound TCP port, 0 for Unix sockets.
+    [[nodiscard]] uint16_t port() const noexcept;
+
+private:
+    std::unique_ptr<detail::StatusServerImpl> mImpl;
+};
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,143 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Pong.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+namespace motdpe {
+
+// Latest known state of one monitored target in a fixed, trivially copyable layout. Text fields are NUL-padded and
+// truncated on a UTF-8 character boundary when the server sends longer values.
+struct StatusRecord {
+    // Target id; 0 is not a valid id.
+    uint64_t id = 0;
+    // Wall-clock time of the last probe in milliseconds since the Unix epoch.
+    int64_t  updatedAt = 0;
+    uint32_t rttUs     = 0;
+    // Consecutive failed probes, 0 while the target answers.
+    uint32_t failures   = 0;
+    int32_t  protocol   = 0;
+    int32_t  online     = 0;
+    int32_t  max        = 0;
+    int32_t  gameModeId = -1;
+    uint16_t portV4     = 0;
+    uint16_t portV6     = 0;
+    // Whether a pong was ever parsed; the pong fields keep the last one while the target is failing.
+    bool                   hasPong = false;
+    std::array<uint8_t, 3> reserved{};
+    std::array<char, 16>   edition{};
+    std::array<char, 32>   version{};
+    std::array<char, 32>   gameMode{};
+    std::array<char, 96>   motd{};
+    std::array<char, 96>   subMotd{};
+
+    // Copies the pong fields, truncating text that does not fit.
+    void setPong(const Pong& pong) noexcept;
+
+    [[nodiscard]] bool ok() const noexcept { return hasPong && failures == 0; }
+
+    template <size_t N>
+    [[nodiscard]] static std::string_view view(const std::array<char, N>& field) noexcept {
+        size_t size = 0;
+        while (size < N && field[size] != '\0') ++size;
+        return {field.data(), size};
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<StatusRecord> && sizeof(StatusRecord) % sizeof(uint64_t) == 0);
+
+namespace detail {
+class SharedMemory;
+struct StatusHeader;
+struct StatusSlot;
+} // namespace detail
+
+// Fixed-capacity table of the latest StatusRecord per target id for read-mostly consumers. Every slot is guarded by
+// a sequence lock: the writer bumps the slot's sequence around each update, and readers copy the record and retry if
+// the sequence moved, so lookups take no lock and perform no atomic read-modify-write, and any number of threads can
+// read while the monitor updates.
+//
+// Writes (publish, erase) must come from one thread at a time, which is the monitor's scheduler thread when the
+// table is passed in MonitorOptions.
+class StatusTable {
+public:
+    // Room for at least `capacity` targets; the slot count is rounded up to keep probe sequences short.
+    explicit StatusTable(size_t capacity);
+    // Same table in a named shared-memory region that other processes open with StatusReader. A region of the same
+    // name is replaced if its publisher closed it or is no longer running; one still in use makes this throw. The
+    // name is removed again when the table is destroyed. Throws on failure.
+    StatusTable(std::string_view sharedName, size_t capacity);
+    ~StatusTable();
+
+    StatusTable(const StatusTable&)            = delete;
+    StatusTable& operator=(const StatusTable&) = delete;
+
+    // Inserts or replaces the record of `record.id`. Returns false, and counts the record in rejected(), if the table
+    // is full.
+    bool publish(const StatusRecord& record) noexcept;
+    void erase(uint64_t id) noexcept;
+
+    // Consistent copy of the latest record, or nothing for unknown ids. Safe to call from any thread.
+    [[nodiscard]] std::optional<StatusRecord> read(uint64_t id) const noexcept;
+    // Record held by slot `index` (< slots()), if the slot holds a live target; used to enumerate the table.
+    [[nodiscard]] std::optional<StatusRecord> readSlot(size_t index) const noexcept;
+
+    [[nodiscard]] size_t slots() const noexcept { return mMask + 1; }
+    [[nodiscard]] size_t size() const noexcept;
+    // Records publish() turned away because every slot held another target; nonzero means the table is too small.
+    [[nodiscard]] uint64_t rejected() const noexcept { return mRejected.load(std::memory_order_relaxed); }
+
+private:
+    void initialize(detail::StatusHeader* header, detail::StatusSlot* slots, size_t slotCount) noexcept;
+
+    // Either the table owns its header and slots, or they live in the shared-memory region.
+    std::unique_ptr<detail::StatusHeader> mOwnHeader;
+    std::unique_ptr<detail::StatusSlot[]> mOwnSlots;
+    std::unique_ptr<detail::SharedMemory> mShared;
+    detail::StatusHeader*                 mHeader = nullptr;
+    detail::StatusSlot*                   mSlots  = nullptr;
+    size_t                                mMask   = 0;
+    std::atomic<uint64_t>                 mRejected{0};
+};
+
+// Read-only view of a StatusTable published by another process under a shared-memory name. Reads never write to the
+// region, so any number of local processes can share one monitor without extra pings or copies through IPC.
+class StatusReader {
+public:
+    // Maps the region; throws if it does not exist or has an incompatible layout.
+    explicit StatusReader(std::string_view sharedName);
+    ~StatusReader();
+
+    StatusReader(StatusReader&&) noexcept;
+    StatusReader& operator=(StatusReader&&) noexcept;
+
+    // As on StatusTable. A slot the publisher left halfway through an update, because it died there, reads as empty
+    // after a bounded number of retries instead of blocking.
+    [[nodiscard]] std::optional<StatusRecord> read(uint64_t id) const noexcept;
+    [[nodiscard]] std::optional<StatusRecord> readSlot(size_t index) const noexcept;
+
+    [[nodiscard]] size_t slots() const noexcept { return mMask + 1; }
+    [[nodiscard]] size_t size() const noexcept;
+    // The publisher has gone away; a restarted one creates a new region, so open the name again.
+    [[nodiscard]] bool closed() const noexcept;
+
+private:
+    std::unique_ptr<detail::SharedMemory> mRegion;
+    const detail::StatusHeader*           mHeader = nullptr;
+    const detail::StatusSlot*             mSlots  = nullptr;
+    size_t                                mMask   = 0;
+};
+
+} // namespace motdpe
\ No newline at end of file
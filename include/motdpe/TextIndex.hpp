@@ -0,0 +1,68 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Pong.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace motdpe {
+
+namespace detail {
+class TextIndexImpl;
+}
+
+struct TextMatch {
+    uint64_t id;
+    // Edits between the needle and the closest substring of the target's text.
+    uint32_t distance;
+};
+
+// Trigram inverted index over the MOTD and sub-MOTD of monitored servers, with formatting codes stripped and ASCII
+// letters folded to lower case. Each trigram maps to a compressed posting list of the servers containing it; a search
+// intersects the lists of the needle's trigrams, rarest first, and confirms the few remaining candidates against the
+// stored text, so searches over 100k servers take well under a millisecond.
+//
+// A monitor with this index in MonitorOptions::text re-indexes a server only when its pong changed, on the indexing
+// thread that also serves MonitorOptions::index. Updates take an exclusive lock; searches share it and may run on any
+// number of threads.
+class TextIndex {
+public:
+    TextIndex();
+    ~TextIndex();
+
+    TextIndex(const TextIndex&)            = delete;
+    TextIndex& operator=(const TextIndex&) = delete;
+
+    // Replaces the indexed text of a target; unchanged text costs one comparison.
+    void update(uint64_t id, const Pong& pong);
+    void update(uint64_t id, std::string_view motd, std::string_view subMotd);
+    bool erase(uint64_t id);
+
+    // Targets whose text contains `needle`, in no particular order. Needles shorter than three characters have no
+    // trigram to look up and scan every text.
+    [[nodiscard]] std::vector<uint64_t> search(std::string_view needle, size_t limit = 50) const;
+
+    // Targets whose text contains `needle` with at most `maxEdits` inserted, deleted or substituted characters,
+    // closest first. For each edit budget d, the needle is split into d + 1 disjoint pieces, and only texts that
+    // contain one of them exactly (found through the trigram index) are checked; when the pieces are shorter than
+    // three characters, every text is scanned. Budgets beyond the length of the normalized needle are clamped to it.
+    [[nodiscard]] std::vector<TextMatch> searchFuzzy(std::string_view needle, uint32_t maxEdits = 1, size_t limit = 50)
+        const;
+
+    [[nodiscard]] size_t size() const;
+    // Posting lists and stored text.
+    [[nodiscard]] size_t memoryBytes() const;
+
+private:
+    std::unique_ptr<detail::TextIndexImpl> mImpl;
+};
+
+} // namespace motdpe
\ No newline at end of file
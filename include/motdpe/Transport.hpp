@@ -0,0 +1,46 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace motdpe {
+
+// A local egress for outbound pings.
+struct PingSource {
+    // Numeric local address to bind, e.g. "192.0.2.10" or "2001:db8::10".
+    std::string address;
+    // Optional network interface to bind to (Linux only).
+    std::string device;
+};
+
+enum class SourceSelection {
+    // Spread consecutive pings over all sources of the target's address family.
+    RoundRobin,
+    // Always ping a given target from the same source.
+    TargetHash,
+};
+
+struct TransportOptions {
+    // Empty: one wildcard IPv4 and one wildcard IPv6 socket.
+    std::vector<PingSource> sources;
+    SourceSelection         selection = SourceSelection::RoundRobin;
+};
+
+struct SourceStats {
+    std::string address;
+    uint64_t    sent       = 0;
+    uint64_t    responses  = 0;
+    uint64_t    timeouts   = 0;
+    uint64_t    sendErrors = 0;
+    // Current send rate granted by this source's rate controller, in pings per second.
+    double rate = 0.0;
+};
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,348 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/Alerts.hpp"
+#include "detail/ChangeLog.hpp"
+#include "detail/Json.hpp"
+#include "detail/Socket.hpp"
+#include "detail/TimingWheel.hpp"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace motdpe {
+
+namespace detail {
+
+constexpr size_t ALERT_FIELDS = static_cast<size_t>(AlertField::GameMode) + 1;
+
+// Hold times are honoured to within one tick; 4096 slots cover about seven minutes per revolution.
+constexpr std::chrono::milliseconds ALERT_TICK{100};
+constexpr size_t                    ALERT_WHEEL_SLOTS = 4096;
+
+using FieldMask = uint32_t;
+
+constexpr FieldMask fieldBit(AlertField field) noexcept { return FieldMask{1} << static_cast<size_t>(field); }
+
+constexpr FieldMask ALL_FIELDS  = (FieldMask{1} << ALERT_FIELDS) - 1;
+constexpr FieldMask PONG_FIELDS = ALL_FIELDS & ~fieldBit(AlertField::Up);
+
+constexpr bool isTextField(AlertField field) noexcept { return field >= AlertField::Version; }
+
+// Last known values of one target.
+struct TargetFacts {
+    bool        up         = false;
+    bool        hasPong    = false;
+    double      players    = 0;
+    double      maxPlayers = 0;
+    double      protocol   = 0;
+    double      rttMs      = 0;
+    std::string version;
+    std::string motd;
+    std::string gameMode;
+
+    [[nodiscard]] double number(AlertField field) const noexcept {
+        switch (field) {
+        case AlertField::Up:
+            return up ? 1 : 0;
+        case AlertField::Players:
+            return players;
+        case AlertField::MaxPlayers:
+            return maxPlayers;
+        case AlertField::PlayerRatio:
+            return maxPlayers > 0 ? players / maxPlayers : 0;
+        case AlertField::Protocol:
+            return protocol;
+        case AlertField::Rtt:
+            return rttMs;
+        default:
+            return 0;
+        }
+    }
+
+    [[nodiscard]] std::string_view text(AlertField field) const noexcept {
+        switch (field) {
+        case AlertField::Version:
+            return version;
+        case AlertField::Motd:
+            return motd;
+        case AlertField::GameMode:
+            return gameMode;
+        default:
+            return {};
+        }
+    }
+};
+
+inline bool holds(const AlertRule& rule, const TargetFacts& facts) noexcept {
+    if (isTextField(rule.field)) {
+        const bool equal = facts.text(rule.field) == rule.text;
+        return rule.op == AlertOp::Equal ? equal : rule.op == AlertOp::NotEqual && !equal;
+    }
+    const double value = facts.number(rule.field);
+    switch (rule.op) {
+    case AlertOp::Equal:
+        return value == rule.value;
+    case AlertOp::NotEqual:
+        return value != rule.value;
+    case AlertOp::Less:
+        return value < rule.value;
+    case AlertOp::LessEqual:
+        return value <= rule.value;
+    case AlertOp::Greater:
+        return value > rule.value;
+    case AlertOp::GreaterEqual:
+        return value >= rule.value;
+    default:
+        return false;
+    }
+}
+
+std::string renderAlert(const Alert& alert) {
+    std::string out = "{\"rule\":";
+    appendJsonString(out, alert.rule.name);
+    out += ",\"ruleId\":";
+    appendNumber(out, alert.ruleId);
+    out += ",\"target\":";
+    appendNumber(out, alert.target);
+    out += ",\"state\":";
+    out += alert.state == AlertState::Firing ? "\"firing\"" : "\"resolved\"";
+    out += ",\"at\":";
+    appendNumber(out, std::chrono::duration_cast<std::chrono::milliseconds>(alert.at.time_since_epoch()).count());
+    out += ",\"value\":";
+    if (isTextField(alert.rule.field)) {
+        appendJsonString(out, alert.text);
+    } else {
+        appendNumber(out, alert.value);
+    }
+    out += '}';
+    return out;
+}
+
+class AlertEvaluator {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit AlertEvaluator(AlertEngine::Sink sink) : mSink(std::move(sink)), mWheel(ALERT_TICK, ALERT_WHEEL_SLOTS) {}
+
+    uint64_t addRule(AlertRule rule) {
+        const bool ordering = rule.op != AlertOp::Equal && rule.op != AlertOp::NotEqual && rule.op != AlertOp::Changed;
+        if (isTextField(rule.field) && ordering) {
+            throw MotdException{
+                std::format("Alert rule {}: text fields only support Equal, NotEqual and Changed", rule.name)
+            };
+        }
+        std::lock_guard lock{mWriterMutex};
+        const uint64_t  id = mNextRuleId++;
+        mLiveRules.insert(id);
+        mChanges.publish(RuleChange{id, std::move(rule)});
+        return id;
+    }
+
+    bool removeRule(uint64_t id) {
+        std::lock_guard lock{mWriterMutex};
+        if (!mLiveRules.erase(id)) return false;
+        mChanges.publish(RuleChange{id, std::nullopt});
+        return true;
+    }
+
+    void process(const MonitorEvent& event, Clock::time_point now) {
+        applyChanges(now);
+
+        const auto [it, inserted] = mFacts.try_emplace(event.id);
+        TargetFacts&    facts     = it->second;
+        // Values seen for the first time are evaluated, but are not a change for Changed rules.
+        const FieldMask fresh     = inserted ? ALL_FIELDS : event.pong && !facts.hasPong ? PONG_FIELDS : 0;
+        FieldMask       changed   = fresh;
+        const auto      update    = [&](AlertField field, auto& slot, const auto& value) {
+            if (slot == value) return;
+            slot     = value;
+            changed |= fieldBit(field);
+        };
+
+        update(AlertField::Up, facts.up, event.ok());
+        if (event.pong) {
+            facts.hasPong = true;
+            update(AlertField::Players, facts.players, static_cast<double>(event.pong->online));
+            update(AlertField::MaxPlayers, facts.maxPlayers, static_cast<double>(event.pong->max));
+            update(AlertField::Protocol, facts.protocol, static_cast<double>(event.pong->protocol));
+            update(AlertField::Rtt, facts.rttMs, std::chrono::duration<double, std::milli>(event.rtt).count());
+            update(AlertField::Version, facts.version, event.pong->version);
+            update(AlertField::Motd, facts.motd, event.pong->motd);
+            update(AlertField::GameMode, facts.gameMode, event.pong->gameMode);
+            if (changed & (fieldBit(AlertField::Players) | fieldBit(AlertField::MaxPlayers))) {
+                changed |= fieldBit(AlertField::PlayerRatio);
+            }
+        }
+
+        const auto targeted = mTargeted.find(event.id);
+        for (size_t field = 0; field < ALERT_FIELDS; ++field) {
+            const FieldMask bit = FieldMask{1} << field;
+            if (!(changed & bit)) continue;
+            const bool initial = fresh & bit;
+            for (const uint64_t rule : mGlobal[field]) evaluate(rule, event.id, facts, initial, now);
+            if (targeted == mTargeted.end()) continue;
+            for (const uint64_t rule : targeted->second[field]) evaluate(rule, event.id, facts, initial, now);
+        }
+    }
+
+    void forget(uint64_t target) {
+        mFacts.erase(target);
+        for (auto& [rule, states] : mStates) states.erase(target);
+    }
+
+    void advance(Clock::time_point now) {
+        applyChanges(now);
+        mWheel.advance(now, [&](const Timer& timer) {
+            const auto rule = mStates.find(timer.rule);
+            if (rule == mStates.end()) return;
+            const auto state = rule->second.find(timer.target);
+            // Stale timers of conditions that stopped holding (or were re-armed) carry an old generation.
+            if (state == rule->second.end() || state->second.generation != timer.generation) return;
+            state->second.firing = true;
+            emit(timer.rule, timer.target, AlertState::Firing);
+        });
+    }
+
+private:
+    struct RuleChange {
+        uint64_t id = 0;
+        // Empty for a removal.
+        std::optional<AlertRule> rule;
+    };
+
+    // A target for which a rule's condition holds; absent while it does not.
+    struct RuleState {
+        uint64_t generation;
+        bool     firing;
+    };
+
+    struct Timer {
+        uint64_t rule;
+        uint64_t target;
+        uint64_t generation;
+    };
+
+    using FieldIndex = std::array<std::vector<uint64_t>, ALERT_FIELDS>;
+
+    void applyChanges(Clock::time_point now) {
+        while (const RuleChange* change = mChanges.next()) {
+            if (!change->rule) {
+                const auto it = mRules.find(change->id);
+                if (it == mRules.end()) continue;
+                std::erase(indexFor(it->second)[static_cast<size_t>(it->second.field)], change->id);
+                mStates.erase(change->id);
+                mRules.erase(it);
+                continue;
+            }
+
+            const AlertRule& rule = mRules.insert_or_assign(change->id, *change->rule).first->second;
+            indexFor(rule)[static_cast<size_t>(rule.field)].push_back(change->id);
+            for (const auto& [target, facts] : mFacts) {
+                if (rule.target == 0 || rule.target == target) evaluate(change->id, target, facts, true, now);
+            }
+        }
+    }
+
+    FieldIndex& indexFor(const AlertRule& rule) { return rule.target == 0 ? mGlobal : mTargeted[rule.target]; }
+
+    void evaluate(uint64_t ruleId, uint64_t target, const TargetFacts& facts, bool initial, Clock::time_point now) {
+        const AlertRule& rule = mRules.at(ruleId);
+        if (rule.field != AlertField::Up && !facts.hasPong) return;
+        if (rule.op == AlertOp::Changed) {
+            if (!initial) emit(ruleId, target, AlertState::Firing);
+            return;
+        }
+
+        auto&      states = mStates[ruleId];
+        const auto it     = states.find(target);
+        if (!holds(rule, facts)) {
+            if (it == states.end()) return;
+            const bool firing = it->second.firing;
+            states.erase(it);
+            if (firing) emit(ruleId, target, AlertState::Resolved);
+            return;
+        }
+        if (it != states.end()) return;
+
+        const RuleState state{mNextGeneration++, rule.holdFor <= std::chrono::milliseconds{0}};
+        states.emplace(target, state);
+        if (state.firing) {
+            emit(ruleId, target, AlertState::Firing);
+        } else {
+            mWheel.schedule(now + rule.holdFor, Timer{ruleId, target, state.generation});
+        }
+    }
+
+    void emit(uint64_t ruleId, uint64_t target, AlertState state) {
+        if (!mSink) return;
+        const AlertRule&   rule  = mRules.at(ruleId);
+        const TargetFacts& facts = mFacts.at(target);
+        mSink(Alert{
+            ruleId,
+            rule,
+            target,
+            state,
+            std::chrono::system_clock::now(),
+            facts.number(rule.field),
+            facts.text(rule.field)
+        });
+    }
+
+    AlertEngine::Sink mSink;
+
+    // Writer side; never touched by the evaluating thread.
+    std::mutex                   mWriterMutex;
+    std::unordered_set<uint64_t> mLiveRules;
+    uint64_t                     mNextRuleId = 1;
+    ChangeLog<RuleChange>        mChanges;
+
+    // Owned by the evaluating thread.
+    std::unordered_map<uint64_t, AlertRule>                               mRules;
+    FieldIndex                                                            mGlobal;
+    std::unordered_map<uint64_t, FieldIndex>                              mTargeted;
+    std::unordered_map<uint64_t, TargetFacts>                             mFacts;
+    std::unordered_map<uint64_t, std::unordered_map<uint64_t, RuleState>> mStates;
+    TimingWheel<Timer>                                                    mWheel;
+    uint64_t                                                              mNextGeneration = 1;
+};
+
+} // namespace detail
+
+AlertEngine::AlertEngine(Sink sink) : mEvaluator(std::make_unique<detail::AlertEvaluator>(std::move(sink))) {}
+
+AlertEngine::~AlertEngine() = default;
+
+AlertEngine::Sink AlertEngine::fileSink(const std::filesystem::path& path) {
+    auto file = std::make_shared<std::ofstream>(path, std::ios::app);
+    if (!*file) throw detail::MotdException{std::format("Failed to open alert file: {}", path.string())};
+    return [file = std::move(file)](const Alert& alert) {
+        std::string line  = detail::renderAlert(alert);
+        line             += '\n';
+        file->write(line.data(), static_cast<std::streamsize>(line.size()));
+        file->flush();
+    };
+}
+
+uint64_t AlertEngine::addRule(AlertRule rule) { return mEvaluator->addRule(std::move(rule)); }
+
+bool AlertEngine::removeRule(uint64_t id) { return mEvaluator->removeRule(id); }
+
+void AlertEngine::process(const MonitorEvent& event, std::chrono::steady_clock::time_point now) {
+    mEvaluator->process(event, now);
+}
+
+void AlertEngine::forget(uint64_t target) { mEvaluator->forget(target); }
+
+void AlertEngine::advance(std::chrono::steady_clock::time_point now) { mEvaluator->advance(now); }
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,561 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/ArrowWriter.hpp"
+#include "detail/FlatBuffer.hpp"
+#include "detail/Socket.hpp"
+#include <array>
+#include <bit>
+#include <format>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace motdpe {
+
+namespace detail {
+
+constexpr std::string_view ARROW_MAGIC = "ARROW1";
+
+// Schema.fbs and Message.fbs of the Arrow columnar format.
+constexpr int16_t  ARROW_METADATA_V5       = 4;
+constexpr uint8_t  ARROW_HEADER_SCHEMA     = 1;
+constexpr uint8_t  ARROW_HEADER_DICTIONARY = 2;
+constexpr uint8_t  ARROW_HEADER_BATCH      = 3;
+constexpr uint8_t  ARROW_TYPE_INT          = 2;
+constexpr uint8_t  ARROW_TYPE_UTF8         = 5;
+constexpr uint8_t  ARROW_TYPE_BOOL         = 6;
+constexpr uint8_t  ARROW_TYPE_TIMESTAMP    = 10;
+constexpr int16_t  ARROW_TIME_UNIT_MS      = 1;
+constexpr int16_t  ARROW_ENDIANNESS        = std::endian::native == std::endian::little ? 0 : 1;
+constexpr uint32_t ARROW_CONTINUATION      = 0xFFFFFFFF;
+
+constexpr size_t ARROW_STATUS_BATCH_ROWS = 65536;
+
+enum class ArrowType : uint8_t {
+    Bool,
+    UInt16,
+    UInt32,
+    UInt64,
+    Int32,
+    TimestampMs,
+    Utf8,
+    // Utf8 values with int32 indices.
+    Dictionary,
+};
+
+struct ArrowField {
+    std::string_view name;
+    ArrowType        type;
+    bool             nullable;
+};
+
+// Buffers of one column of a record batch, viewed until the batch is written.
+struct ArrowColumn {
+    // Bit-packed; empty when the column has no nulls.
+    std::span<const std::byte> validity;
+    size_t                     nullCount = 0;
+    // Int32 offsets of Utf8 columns.
+    std::span<const std::byte> offsets;
+    std::span<const std::byte> values;
+};
+
+template <typename T>
+std::span<const std::byte> bytesOf(std::span<const T> values) noexcept {
+    return std::as_bytes(values);
+}
+
+template <typename T>
+std::span<const std::byte> bytesOf(const std::vector<T>& values) noexcept {
+    return std::as_bytes(std::span{values});
+}
+
+// Bit-packed flags, least significant bit first.
+template <typename Predicate>
+std::vector<uint8_t> packBits(size_t count, Predicate&& predicate) {
+    std::vector<uint8_t> bits((count + 7) / 8);
+    for (size_t i = 0; i < count; ++i) {
+        if (predicate(i)) bits[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+    }
+    return bits;
+}
+
+struct Utf8Builder {
+    std::vector<int32_t> offsets{0};
+    std::string          bytes;
+
+    void push_back(std::string_view text) {
+        if (text.size() > static_cast<size_t>(INT32_MAX) - bytes.size()) {
+            throw MotdException{"Arrow text column exceeds 2 GiB"};
+        }
+        bytes.append(text);
+        offsets.push_back(static_cast<int32_t>(bytes.size()));
+    }
+};
+
+class ArrowFileWriter {
+public:
+    using Builder = FlatBufferBuilder;
+    using Writer  = Builder::Writer;
+
+    ArrowFileWriter(const std::filesystem::path& path, std::vector<ArrowField> fields)
+    : mFields(std::move(fields)),
+      mDictionaries(mFields.size()),
+      mFile(path, std::ios::binary | std::ios::trunc) {
+        if (!mFile) throw MotdException{std::format("Failed to open Arrow file: {}", path.string())};
+        for (Dictionary& dictionary : mDictionaries) intern(dictionary, {});
+        // The magic is padded to 8 bytes; the stream format follows.
+        writeBytes(ARROW_MAGIC.data(), ARROW_MAGIC.size());
+        writeBytes("\0\0", 2);
+        writeMessage(ARROW_HEADER_SCHEMA, schema(), nullptr, nullptr);
+    }
+
+    ~ArrowFileWriter() {
+        try {
+            close();
+        } catch (...) {} // NOLINT(bugprone-empty-catch)
+    }
+
+    // Global dictionary id of a value of a dictionary field.
+    int32_t intern(size_t field, std::string_view value) { return intern(mDictionaries[field], value); }
+
+    // Maps the ids of a chunk-local dictionary to global ids; returns false if they are identical.
+    bool remap(size_t field, std::span<const std::string> values, std::vector<int32_t>& mapping) {
+        mapping.resize(values.size());
+        bool identity = true;
+        for (size_t i = 0; i < values.size(); ++i) {
+            mapping[i]  = intern(field, values[i]);
+            identity   &= mapping[i] == static_cast<int32_t>(i);
+        }
+        return !identity;
+    }
+
+    void writeBatch(size_t rows, std::span<const ArrowColumn> columns) {
+        if (mClosed) throw MotdException{"Arrow writer is closed"};
+        // Values new since the last batch go out first, as a delta after the initial dictionary.
+        for (size_t field = 0; field < mFields.size(); ++field) {
+            Dictionary& dictionary = mDictionaries[field];
+            if (mFields[field].type == ArrowType::Dictionary && dictionary.written < dictionary.values.size()) {
+                writeDictionary(field);
+            }
+        }
+
+        Body body;
+        for (size_t i = 0; i < columns.size(); ++i) body.column(mFields[i].type, rows, columns[i]);
+        const Writer header = [&](Builder& builder) { return recordBatch(builder, rows, body); };
+        writeMessage(ARROW_HEADER_BATCH, header, &body, &mBlocks);
+    }
+
+    void close() {
+        if (mClosed) return;
+        mClosed = true;
+        // End-of-stream marker, then the footer indexing every message.
+        writeWord(ARROW_CONTINUATION);
+        writeWord(0);
+        Builder    builder;
+        const auto footer = builder.finish([&](Builder& b) {
+            const std::array fields{
+                Builder::scalar(0, ARROW_METADATA_V5),
+                Builder::object(1, schema()),
+                Builder::object(2, [&](Builder& c) { return c.structs(mDictionaryBlocks, 3); }),
+                Builder::object(3, [&](Builder& c) { return c.structs(mBlocks, 3); }),
+            };
+            return b.table(fields);
+        });
+        writeBytes(footer.data(), footer.size());
+        writeWord(static_cast<uint32_t>(footer.size()));
+        writeBytes(ARROW_MAGIC.data(), ARROW_MAGIC.size());
+        mFile.flush();
+        if (!mFile) throw MotdException{"Failed to write Arrow file"};
+    }
+
+private:
+    struct Dictionary {
+        std::unordered_map<std::string, int32_t> ids;
+        std::vector<std::string>                 values;
+        size_t                                   written = 0;
+    };
+
+    // Body buffers of a message, each padded to 8 bytes, with the node and buffer descriptions of RecordBatch.
+    struct Body {
+        std::vector<std::span<const std::byte>> parts;
+        std::vector<uint64_t>                   nodes;
+        std::vector<uint64_t>                   buffers;
+        uint64_t                                length = 0;
+
+        void add(std::span<const std::byte> part) {
+            buffers.push_back(length);
+            buffers.push_back(part.size());
+            parts.push_back(part);
+            length += (part.size() + 7) / 8 * 8;
+        }
+
+        void column(ArrowType type, size_t rows, const ArrowColumn& column) {
+            nodes.push_back(rows);
+            nodes.push_back(column.nullCount);
+            add(column.nullCount ? column.validity : std::span<const std::byte>{});
+            if (type == ArrowType::Utf8) add(column.offsets);
+            add(column.values);
+        }
+    };
+
+    static int32_t intern(Dictionary& dictionary, std::string_view value) {
+        const auto [it, inserted] =
+            dictionary.ids.try_emplace(std::string{value}, static_cast<int32_t>(dictionary.values.size()));
+        if (inserted) dictionary.values.emplace_back(value);
+        return it->second;
+    }
+
+    static uint32_t intType(Builder& builder, int32_t bits, bool isSigned) {
+        const std::array fields{Builder::scalar(0, bits), Builder::scalar(1, isSigned)};
+        return builder.table(fields);
+    }
+
+    static uint32_t recordBatch(Builder& builder, size_t rows, const Body& body) {
+        const std::array fields{
+            Builder::scalar(0, static_cast<int64_t>(rows)),
+            Builder::object(1, [&](Builder& b) { return b.structs(body.nodes, 2); }),
+            Builder::object(2, [&](Builder& b) { return b.structs(body.buffers, 2); }),
+        };
+        return builder.table(fields);
+    }
+
+    Writer field(size_t index) const {
+        return [this, index](Builder& builder) {
+            const ArrowField& field = mFields[index];
+            uint8_t           type  = ARROW_TYPE_UTF8;
+            Writer            typeTable;
+            switch (field.type) {
+            case ArrowType::Bool:
+                type      = ARROW_TYPE_BOOL;
+                typeTable = [](Builder& b) { return b.table({}); };
+                break;
+            case ArrowType::UInt16:
+            case ArrowType::UInt32:
+            case ArrowType::UInt64:
+            case ArrowType::Int32: {
+                const int32_t bits = field.type == ArrowType::UInt16 ? 16 : field.type == ArrowType::UInt64 ? 64 : 32;
+                type               = ARROW_TYPE_INT;
+                typeTable = [bits, isSigned = field.type == ArrowType::Int32](Builder& b) {
+                    return intType(b, bits, isSigned);
+                };
+                break;
+            }
+            case ArrowType::TimestampMs:
+                type      = ARROW_TYPE_TIMESTAMP;
+                typeTable = [](Builder& b) {
+                    const std::array fields{
+                        Builder::scalar(0, ARROW_TIME_UNIT_MS),
+                        Builder::object(1, [](Builder& c) { return c.string("UTC"); }),
+                    };
+                    return b.table(fields);
+                };
+                break;
+            case ArrowType::Utf8:
+            case ArrowType::Dictionary:
+                typeTable = [](Builder& b) { return b.table({}); };
+                break;
+            }
+
+            std::vector<Builder::Field> fields{
+                Builder::object(0, [&](Builder& b) { return b.string(field.name); }),
+                Builder::scalar(1, field.nullable),
+                Builder::scalar(2, type),
+                Builder::object(3, typeTable),
+            };
+            if (field.type == ArrowType::Dictionary) {
+                fields.push_back(Builder::object(4, [index](Builder& b) {
+                    const std::array encoding{
+                        Builder::scalar(0, static_cast<int64_t>(index)),
+                        Builder::object(1, [](Builder& c) { return intType(c, 32, true); }),
+                    };
+                    return b.table(encoding);
+                }));
+            }
+            // Readers expect a children vector even for primitive types.
+            fields.push_back(Builder::object(5, [](Builder& b) { return b.vector({}); }));
+            return builder.table(fields);
+        };
+    }
+
+    Writer schema() const {
+        return [this](Builder& builder) {
+            std::vector<Writer> fields;
+            for (size_t i = 0; i < mFields.size(); ++i) fields.push_back(field(i));
+            const std::array schema{
+                Builder::scalar(0, ARROW_ENDIANNESS),
+                Builder::object(1, [&](Builder& b) { return b.vector(fields); }),
+            };
+            return builder.table(schema);
+        };
+    }
+
+    void writeDictionary(size_t field) {
+        Dictionary& dictionary = mDictionaries[field];
+        Utf8Builder values;
+        for (size_t i = dictionary.written; i < dictionary.values.size(); ++i) values.push_back(dictionary.values[i]);
+        const size_t count = dictionary.values.size() - dictionary.written;
+
+        Body body;
+        body.column(
+            ArrowType::Utf8,
+            count,
+            ArrowColumn{{}, 0, bytesOf(values.offsets), std::as_bytes(std::span{values.bytes})}
+        );
+        const bool   delta  = dictionary.written > 0;
+        const Writer header = [&](Builder& builder) {
+            const std::array fields{
+                Builder::scalar(0, static_cast<int64_t>(field)),
+                Builder::object(1, [&](Builder& b) { return recordBatch(b, count, body); }),
+                Builder::scalar(2, delta),
+            };
+            return builder.table(fields);
+        };
+        writeMessage(ARROW_HEADER_DICTIONARY, header, &body, &mDictionaryBlocks);
+        dictionary.written = dictionary.values.size();
+    }
+
+    // Encapsulated message: continuation marker, metadata length, Message flatbuffer, body. Appends its Block
+    // (offset, metadata length, body length) to `blocks` for the footer.
+    void writeMessage(uint8_t headerType, const Writer& header, const Body* body, std::vector<uint64_t>* blocks) {
+        const uint64_t bodyLength = body ? body->length : 0;
+        Builder        builder;
+        const auto     metadata = builder.finish([&](Builder& b) {
+            const std::array fields{
+                Builder::scalar(0, ARROW_METADATA_V5),
+                Builder::scalar(1, headerType),
+                Builder::object(2, header),
+                Builder::scalar(3, static_cast<int64_t>(bodyLength)),
+            };
+            return b.table(fields);
+        });
+
+        const uint64_t offset = mPosition;
+        writeWord(ARROW_CONTINUATION);
+        writeWord(static_cast<uint32_t>(metadata.size()));
+        writeBytes(metadata.data(), metadata.size());
+        if (body) {
+            static constexpr std::array<char, 8> padding{};
+            for (const auto part : body->parts) {
+                writeBytes(part.data(), part.size());
+                writeBytes(padding.data(), (8 - part.size() % 8) % 8);
+            }
+        }
+        if (!mFile) throw MotdException{"Failed to write Arrow file"};
+        if (blocks) blocks->insert(blocks->end(), {offset, 8 + metadata.size(), bodyLength});
+    }
+
+    void writeBytes(const void* data, size_t size) {
+        mFile.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        mPosition += size;
+    }
+
+    void writeWord(uint32_t value) {
+        const std::array<uint8_t, 4> bytes{
+            static_cast<uint8_t>(value),
+            static_cast<uint8_t>(value >> 8),
+            static_cast<uint8_t>(value >> 16),
+            static_cast<uint8_t>(value >> 24)
+        };
+        writeBytes(bytes.data(), bytes.size());
+    }
+
+    std::vector<ArrowField> mFields;
+    std::vector<Dictionary> mDictionaries;
+    std::ofstream           mFile;
+    uint64_t                mPosition = 0;
+    std::vector<uint64_t>   mDictionaryBlocks;
+    std::vector<uint64_t>   mBlocks;
+    bool                    mClosed = false;
+};
+
+constexpr std::array<ArrowField, 14> ARROW_SCAN_FIELDS{
+    ArrowField{"target", ArrowType::UInt32, false},
+    ArrowField{"address", ArrowType::Utf8, false},
+    ArrowField{"port", ArrowType::UInt16, false},
+    ArrowField{"ok", ArrowType::Bool, false},
+    ArrowField{"rtt_us", ArrowType::UInt32, true},
+    ArrowField{"online", ArrowType::Int32, true},
+    ArrowField{"max", ArrowType::Int32, true},
+    ArrowField{"protocol", ArrowType::Int32, true},
+    ArrowField{"edition", ArrowType::Dictionary, true},
+    ArrowField{"version", ArrowType::Dictionary, true},
+    ArrowField{"game_mode", ArrowType::Dictionary, true},
+    ArrowField{"motd", ArrowType::Utf8, true},
+    ArrowField{"sub_motd", ArrowType::Utf8, true},
+    ArrowField{"error", ArrowType::Utf8, true},
+};
+
+constexpr std::array<ArrowField, 13> ARROW_STATUS_FIELDS{
+    ArrowField{"id", ArrowType::UInt64, false},
+    ArrowField{"updated_at", ArrowType::TimestampMs, false},
+    ArrowField{"ok", ArrowType::Bool, false},
+    ArrowField{"failures", ArrowType::UInt32, false},
+    ArrowField{"rtt_us", ArrowType::UInt32, true},
+    ArrowField{"online", ArrowType::Int32, true},
+    ArrowField{"max", ArrowType::Int32, true},
+    ArrowField{"protocol", ArrowType::Int32, true},
+    ArrowField{"edition", ArrowType::Dictionary, true},
+    ArrowField{"version", ArrowType::Dictionary, true},
+    ArrowField{"game_mode", ArrowType::Dictionary, true},
+    ArrowField{"motd", ArrowType::Utf8, true},
+    ArrowField{"sub_motd", ArrowType::Utf8, true},
+};
+
+// Streams the live records of a table or reader in batches.
+template <typename Table>
+void writeStatus(ArrowFileWriter& writer, const Table& table) {
+    std::vector<StatusRecord> records;
+    records.reserve(std::min(table.slots(), ARROW_STATUS_BATCH_ROWS));
+    const auto flush = [&] {
+        const size_t          rows = records.size();
+        std::vector<uint64_t> ids(rows);
+        std::vector<int64_t>  updatedAt(rows);
+        std::vector<uint32_t> failures(rows);
+        std::vector<uint32_t> rtt(rows);
+        std::vector<int32_t>  online(rows);
+        std::vector<int32_t>  max(rows);
+        std::vector<int32_t>  protocol(rows);
+        std::vector<int32_t>  edition(rows);
+        std::vector<int32_t>  version(rows);
+        std::vector<int32_t>  gameMode(rows);
+        Utf8Builder           motd;
+        Utf8Builder           subMotd;
+        size_t                pongs = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            const StatusRecord& record = records[i];
+            ids[i]                     = record.id;
+            updatedAt[i]               = record.updatedAt;
+            failures[i]                = record.failures;
+            rtt[i]                     = record.rttUs;
+            online[i]                  = record.online;
+            max[i]                     = record.max;
+            protocol[i]                = record.protocol;
+            edition[i]                 = writer.intern(8, StatusRecord::view(record.edition));
+            version[i]                 = writer.intern(9, StatusRecord::view(record.version));
+            gameMode[i]                = writer.intern(10, StatusRecord::view(record.gameMode));
+            motd.push_back(StatusRecord::view(record.motd));
+            subMotd.push_back(StatusRecord::view(record.subMotd));
+            pongs += record.hasPong ? 1 : 0;
+        }
+        const auto ok       = packBits(rows, [&](size_t i) { return records[i].ok(); });
+        const auto hasPong  = packBits(rows, [&](size_t i) { return records[i].hasPong; });
+        const auto validity = std::as_bytes(std::span{hasPong});
+        const auto nulls    = rows - pongs;
+
+        const std::array<ArrowColumn, ARROW_STATUS_FIELDS.size()> columns{
+            ArrowColumn{{}, 0, {}, bytesOf(ids)},
+            ArrowColumn{{}, 0, {}, bytesOf(updatedAt)},
+            ArrowColumn{{}, 0, {}, std::as_bytes(std::span{ok})},
+            ArrowColumn{{}, 0, {}, bytesOf(failures)},
+            ArrowColumn{validity, nulls, {}, bytesOf(rtt)},
+            ArrowColumn{validity, nulls, {}, bytesOf(online)},
+            ArrowColumn{validity, nulls, {}, bytesOf(max)},
+            ArrowColumn{validity, nulls, {}, bytesOf(protocol)},
+            ArrowColumn{validity, nulls, {}, bytesOf(edition)},
+            ArrowColumn{validity, nulls, {}, bytesOf(version)},
+            ArrowColumn{validity, nulls, {}, bytesOf(gameMode)},
+            ArrowColumn{validity, nulls, bytesOf(motd.offsets), std::as_bytes(std::span{motd.bytes})},
+            ArrowColumn{validity, nulls, bytesOf(subMotd.offsets), std::as_bytes(std::span{subMotd.bytes})},
+        };
+        writer.writeBatch(rows, columns);
+        records.clear();
+    };
+
+    for (size_t slot = 0; slot < table.slots(); ++slot) {
+        if (auto record = table.readSlot(slot)) records.push_back(*record);
+        if (records.size() == ARROW_STATUS_BATCH_ROWS) flush();
+    }
+    if (!records.empty()) flush();
+}
+
+} // namespace detail
+
+ArrowWriter::ArrowWriter(const std::filesystem::path& path, ArrowTable table)
+: mWriter(std::make_unique<detail::ArrowFileWriter>(
+      path,
+      table == ArrowTable::Scan
+          ? std::vector<detail::ArrowField>(detail::ARROW_SCAN_FIELDS.begin(), detail::ARROW_SCAN_FIELDS.end())
+          : std::vector<detail::ArrowField>(detail::ARROW_STATUS_FIELDS.begin(), detail::ARROW_STATUS_FIELDS.end())
+  )),
+  mTable(table) {}
+
+ArrowWriter::~ArrowWriter() = default;
+
+void ArrowWriter::write(const BatchColumns& columns) {
+    using detail::ArrowColumn;
+    using detail::bytesOf;
+    if (mTable != ArrowTable::Scan) throw detail::MotdException{"Batch columns need an ArrowTable::Scan writer"};
+    const size_t rows = columns.size();
+    if (columns.motd.bytes().size() > INT32_MAX || columns.subMotd.bytes().size() > INT32_MAX
+        || columns.error.bytes().size() > INT32_MAX) {
+        throw detail::MotdException{"Arrow text column exceeds 2 GiB"};
+    }
+
+    detail::Utf8Builder   address;
+    std::vector<uint16_t> ports(rows);
+    size_t                okCount = 0;
+    for (size_t i = 0; i < rows; ++i) {
+        address.push_back(columns.endpoint[i].addressString());
+        ports[i]  = columns.endpoint[i].port;
+        okCount  += columns.ok[i];
+    }
+    const auto ok     = detail::packBits(rows, [&](size_t i) { return columns.ok[i] != 0; });
+    const auto failed = detail::packBits(rows, [&](size_t i) { return columns.ok[i] == 0; });
+    const auto valid  = std::as_bytes(std::span{ok});
+    const auto nulls  = rows - okCount;
+
+    // Dictionary ids are written as they are when the columns' dictionaries agree with the file's so far.
+    std::array<std::vector<int32_t>, 3> remapped;
+    const auto                          dictionary = [&](size_t field, const DictionaryColumn& column) {
+        std::vector<int32_t>& ids = remapped[field - 8];
+        std::vector<int32_t>  mapping;
+        if (!mWriter->remap(field, column.values(), mapping)) return bytesOf(column.ids());
+        ids.resize(rows);
+        for (size_t i = 0; i < rows; ++i) ids[i] = mapping[column.ids()[i]];
+        return bytesOf(ids);
+    };
+    const auto text = [](const TextColumn& column) {
+        return std::pair{bytesOf(column.offsets()), std::as_bytes(std::span{column.bytes()})};
+    };
+    const auto [motdOffsets, motdBytes]       = text(columns.motd);
+    const auto [subMotdOffsets, subMotdBytes] = text(columns.subMotd);
+    const auto [errorOffsets, errorBytes]     = text(columns.error);
+
+    const std::array<ArrowColumn, detail::ARROW_SCAN_FIELDS.size()> arrowColumns{
+        ArrowColumn{{}, 0, {}, bytesOf(columns.target)},
+        ArrowColumn{{}, 0, bytesOf(address.offsets), std::as_bytes(std::span{address.bytes})},
+        ArrowColumn{{}, 0, {}, bytesOf(ports)},
+        ArrowColumn{{}, 0, {}, valid},
+        ArrowColumn{valid, nulls, {}, bytesOf(columns.rttUs)},
+        ArrowColumn{valid, nulls, {}, bytesOf(columns.online)},
+        ArrowColumn{valid, nulls, {}, bytesOf(columns.max)},
+        ArrowColumn{valid, nulls, {}, bytesOf(columns.protocol)},
+        ArrowColumn{valid, nulls, {}, dictionary(8, columns.edition)},
+        ArrowColumn{valid, nulls, {}, dictionary(9, columns.version)},
+        ArrowColumn{valid, nulls, {}, dictionary(10, columns.gameMode)},
+        ArrowColumn{valid, nulls, motdOffsets, motdBytes},
+        ArrowColumn{valid, nulls, subMotdOffsets, subMotdBytes},
+        ArrowColumn{std::as_bytes(std::span{failed}), okCount, errorOffsets, errorBytes},
+    };
+    mWriter->writeBatch(rows, arrowColumns);
+}
+
+void ArrowWriter::write(const StatusTable& table) {
+    if (mTable != ArrowTable::Status) throw detail::MotdException{"Status tables need an ArrowTable::Status writer"};
+    detail::writeStatus(*mWriter, table);
+}
+
+void ArrowWriter::write(const StatusReader& reader) {
+    if (mTable != ArrowTable::Status) throw detail::MotdException{"Status tables need an ArrowTable::Status writer"};
+    detail::writeStatus(*mWriter, reader);
+}
+
+void ArrowWriter::close() { mWriter->close(); }
+
+} // namespace motdpe
\ No newline at end of file
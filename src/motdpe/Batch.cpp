@@ -0,0 +1,131 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/Batch.hpp"
+#include "motdpe/BatchColumns.hpp"
+#include "detail/PingEngine.hpp"
+#include <algorithm>
+#include <format>
+#include <limits>
+#include <unordered_map>
+
+namespace motdpe {
+
+namespace detail {
+
+constexpr size_t BATCH_NPOS = std::numeric_limits<size_t>::max();
+
+// Resolves and pings the targets, reporting every target that is not an alias exactly once, either through
+// `onPong(index, endpoint, payload, rtt)` or `onError(index, endpoint, message)`. Returns for each target the index of
+// the earlier target resolving to the same endpoint, or BATCH_NPOS.
+template <typename OnPong, typename OnError>
+std::vector<size_t>
+runBatch(std::span<const BatchTarget> targets, const BatchOptions& options, OnPong&& onPong, OnError&& onError) {
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<Endpoint> endpoints(targets.size());
+    std::vector<size_t>   aliasOf(targets.size(), BATCH_NPOS);
+    std::vector<size_t>   queue;
+    queue.reserve(targets.size());
+
+    std::unordered_map<Endpoint, size_t, EndpointHash> primary;
+    for (size_t i = 0; i < targets.size(); ++i) {
+        try {
+            endpoints[i] = Endpoint::resolve(targets[i].host, targets[i].port).front();
+        } catch (const std::exception& e) {
+            onError(i, endpoints[i], e.what());
+            continue;
+        }
+        if (const auto [it, inserted] = primary.try_emplace(endpoints[i], i); !inserted) {
+            aliasOf[i] = it->second;
+        } else {
+            queue.push_back(i);
+        }
+    }
+
+    PingEngine engine{options.transport, options.rate};
+    size_t     next = 0;
+
+    while (next < queue.size() || engine.inFlight() > 0) {
+        auto now = Clock::now();
+
+        for (; next < queue.size(); ++next) {
+            using enum PingEngine::SendResult;
+            const size_t index  = queue[next];
+            const auto   result = engine.send(endpoints[index], index, now + options.timeout);
+            if (result == RateLimited || result == WouldBlock) break;
+            if (result == Failed) {
+                onError(index, endpoints[index], std::format("Send failed for {}", endpoints[index].toString()));
+            }
+        }
+
+        while (auto pong = engine.receive()) onPong(pong->token, endpoints[pong->token], pong->motd, pong->rtt);
+
+        now = Clock::now();
+        while (auto expired = engine.expire(now)) {
+            onError(
+                expired->token,
+                endpoints[expired->token],
+                std::format("Timed out waiting for pong from {}", expired->endpoint.toString())
+            );
+        }
+
+        auto until = engine.nextDeadline();
+        if (next < queue.size()) until = std::min(until.value_or(Clock::time_point::max()), engine.nextSendTime());
+        if (until) engine.wait(*until);
+    }
+    return aliasOf;
+}
+
+} // namespace detail
+
+std::vector<BatchResult> queryMotdBatch(std::span<const BatchTarget> targets, const BatchOptions& options) {
+    std::vector<BatchResult> results(targets.size());
+
+    const auto aliasOf = detail::runBatch(
+        targets,
+        options,
+        [&](size_t index, const Endpoint&, std::string_view payload, std::chrono::microseconds rtt) {
+            results[index].motd = std::string{payload};
+            results[index].rtt  = rtt;
+        },
+        [&](size_t index, const Endpoint&, std::string_view message) { results[index].error = message; }
+    );
+
+    for (size_t i = 0; i < targets.size(); ++i) {
+        if (aliasOf[i] != detail::BATCH_NPOS) results[i] = results[aliasOf[i]];
+    }
+    return results;
+}
+
+BatchColumns queryMotdBatchColumns(std::span<const BatchTarget> targets, const BatchOptions& options) {
+    if (targets.size() > UINT32_MAX) throw detail::MotdException{"Too many targets for one batch"};
+
+    BatchColumns        columns;
+    std::vector<size_t> rowOf(targets.size());
+    columns.reserve(targets.size());
+
+    const auto aliasOf = detail::runBatch(
+        targets,
+        options,
+        [&](size_t index, const Endpoint& endpoint, std::string_view payload, std::chrono::microseconds rtt) {
+            rowOf[index] = columns.size();
+            columns.appendPong(static_cast<uint32_t>(index), endpoint, payload, rtt);
+        },
+        [&](size_t index, const Endpoint& endpoint, std::string_view message) {
+            rowOf[index] = columns.size();
+            columns.appendFailure(static_cast<uint32_t>(index), endpoint, message);
+        }
+    );
+
+    for (size_t i = 0; i < targets.size(); ++i) {
+        if (aliasOf[i] != detail::BATCH_NPOS) columns.duplicate(rowOf[aliasOf[i]], static_cast<uint32_t>(i));
+    }
+    return columns;
+}
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,145 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/BatchColumns.hpp"
+#include "detail/PongFields.hpp"
+#include "detail/Socket.hpp"
+#include <algorithm>
+
+namespace motdpe {
+
+namespace {
+
+void ensureRoom(const TextColumn& column, size_t bytes) {
+    if (!column.fits(bytes)) throw detail::MotdException{"Text column exceeds 4 GiB"};
+}
+
+} // namespace
+
+void TextColumn::push_back(std::string_view text) {
+    ensureRoom(*this, text.size());
+    mBytes.append(text);
+    mOffsets.push_back(static_cast<uint32_t>(mBytes.size()));
+}
+
+void TextColumn::duplicate(size_t row) {
+    const uint32_t begin = mOffsets[row];
+    const uint32_t size  = mOffsets[row + 1] - begin;
+    ensureRoom(*this, size);
+    // Copied by position, since appending may reallocate the bytes a view would point into.
+    mBytes.append(mBytes, begin, size);
+    mOffsets.push_back(static_cast<uint32_t>(mBytes.size()));
+}
+
+void TextColumn::reserve(size_t rows, size_t bytes) {
+    mOffsets.reserve(rows + 1);
+    mBytes.reserve(bytes);
+}
+
+DictionaryColumn::DictionaryColumn() : mValues(1), mLookup{{std::string{}, 0}} {}
+
+void DictionaryColumn::push_back(std::string_view value) {
+    auto it = mLookup.find(value);
+    if (it == mLookup.end()) {
+        it = mLookup.emplace(std::string{value}, static_cast<uint32_t>(mValues.size())).first;
+        mValues.emplace_back(value);
+    }
+    mIds.push_back(it->second);
+}
+
+void BatchColumns::reserve(size_t rows) {
+    target.reserve(rows);
+    endpoint.reserve(rows);
+    ok.reserve(rows);
+    rttUs.reserve(rows);
+    online.reserve(rows);
+    max.reserve(rows);
+    protocol.reserve(rows);
+    edition.reserve(rows);
+    version.reserve(rows);
+    gameMode.reserve(rows);
+    // Typical MOTDs are a few dozen bytes.
+    motd.reserve(rows, rows * 32);
+    subMotd.reserve(rows, rows * 16);
+    error.reserve(rows, 0);
+}
+
+void BatchColumns::appendPong(
+    uint32_t                  index,
+    const Endpoint&           address,
+    std::string_view          payload,
+    std::chrono::microseconds rtt
+) {
+    detail::PongFields fields;
+    if (detail::splitPongFields(payload, fields) < detail::PONG_REQUIRED_COUNT) {
+        appendFailure(index, address, "Malformed pong payload");
+        return;
+    }
+
+    // Malformed numbers read as 0, as in parsePong().
+    int32_t protocolNumber = 0;
+    int32_t players        = 0;
+    int32_t slots          = 0;
+    detail::parseNumber(fields[2], protocolNumber);
+    detail::parseNumber(fields[4], players);
+    detail::parseNumber(fields[5], slots);
+
+    // Checked before any column grows, so that a throw cannot leave the columns with different lengths.
+    ensureRoom(motd, fields[1].size());
+    ensureRoom(subMotd, fields[7].size());
+    target.push_back(index);
+    endpoint.push_back(address);
+    ok.push_back(1);
+    rttUs.push_back(static_cast<uint32_t>(std::clamp<int64_t>(rtt.count(), 0, UINT32_MAX)));
+    online.push_back(players);
+    max.push_back(slots);
+    protocol.push_back(protocolNumber);
+    edition.push_back(fields[0]);
+    version.push_back(fields[3]);
+    gameMode.push_back(fields[8]);
+    motd.push_back(fields[1]);
+    subMotd.push_back(fields[7]);
+    error.push_back({});
+}
+
+void BatchColumns::appendFailure(uint32_t index, const Endpoint& address, std::string_view reason) {
+    ensureRoom(error, reason.size());
+    target.push_back(index);
+    endpoint.push_back(address);
+    ok.push_back(0);
+    rttUs.push_back(0);
+    online.push_back(0);
+    max.push_back(0);
+    protocol.push_back(0);
+    edition.push_back({});
+    version.push_back({});
+    gameMode.push_back({});
+    motd.push_back({});
+    subMotd.push_back({});
+    error.push_back(reason);
+}
+
+void BatchColumns::duplicate(size_t row, uint32_t index) {
+    ensureRoom(motd, motd[row].size());
+    ensureRoom(subMotd, subMotd[row].size());
+    ensureRoom(error, error[row].size());
+    target.push_back(index);
+    endpoint.push_back(endpoint[row]);
+    ok.push_back(ok[row]);
+    rttUs.push_back(rttUs[row]);
+    online.push_back(online[row]);
+    max.push_back(max[row]);
+    protocol.push_back(protocol[row]);
+    edition.duplicate(row);
+    version.duplicate(row);
+    gameMode.duplicate(row);
+    motd.duplicate(row);
+    subMotd.duplicate(row);
+    error.duplicate(row);
+}
+
+} // namespace motdpe
\ No newline at end of file
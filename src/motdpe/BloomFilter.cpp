@@ -0,0 +1,116 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/BloomFilter.hpp"
+#include "detail/Permutation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numbers>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace motdpe {
+
+namespace detail {
+
+// Odd multipliers that spread one 32-bit hash into eight independent bit positions (as in Parquet's split-block
+// Bloom filter).
+alignas(32) constexpr std::array<uint32_t, 8> BLOOM_SALT =
+    {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+#if defined(__AVX2__)
+// Bit masks for the two halves of a block.
+struct BloomMasks {
+    __m256i low;
+    __m256i high;
+};
+
+inline BloomMasks bloomMasks(uint32_t hash) noexcept {
+    const __m256i salt  = _mm256_load_si256(reinterpret_cast<const __m256i*>(BLOOM_SALT.data()));
+    const __m256i shift = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(hash)), salt), 26);
+    const __m256i one   = _mm256_set1_epi64x(1);
+    return BloomMasks{
+        _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(shift))),
+        _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(shift, 1)))
+    };
+}
+#else
+inline std::array<uint64_t, 8> bloomMasks(uint32_t hash) noexcept {
+    std::array<uint64_t, 8> masks;
+    for (size_t i = 0; i < masks.size(); ++i) masks[i] = uint64_t{1} << ((hash * BLOOM_SALT[i]) >> 26);
+    return masks;
+}
+#endif
+
+} // namespace detail
+
+BloomFilter::BloomFilter(uint64_t expectedItems, double falsePositiveRate) {
+    // Classic sizing plus 10%, which makes up for the uneven load across blocks at the usual rates.
+    const double rate = std::clamp(falsePositiveRate, 1e-9, 0.5);
+    const double bits = 1.1 * static_cast<double>(std::max<uint64_t>(expectedItems, 1)) * -std::log(rate)
+                      / (std::numbers::ln2 * std::numbers::ln2);
+    mBlocks.resize(std::max<size_t>(static_cast<size_t>(std::ceil(bits / (8.0 * sizeof(Block)))), 1));
+}
+
+BloomFilter::Block& BloomFilter::blockFor(uint64_t hash) noexcept {
+    return mBlocks[static_cast<size_t>(((hash >> 32) * mBlocks.size()) >> 32)];
+}
+
+const BloomFilter::Block& BloomFilter::blockFor(uint64_t hash) const noexcept {
+    return mBlocks[static_cast<size_t>(((hash >> 32) * mBlocks.size()) >> 32)];
+}
+
+bool BloomFilter::contains(uint64_t hash) const noexcept {
+    const Block& block = blockFor(hash);
+#if defined(__AVX2__)
+    const auto [low, high] = detail::bloomMasks(static_cast<uint32_t>(hash));
+    const auto* words      = reinterpret_cast<const __m256i*>(block.words.data());
+    return _mm256_testc_si256(_mm256_load_si256(words), low) && _mm256_testc_si256(_mm256_load_si256(words + 1), high);
+#else
+    const auto masks = detail::bloomMasks(static_cast<uint32_t>(hash));
+    uint64_t   miss  = 0;
+    for (size_t i = 0; i < masks.size(); ++i) miss |= masks[i] & ~block.words[i];
+    return miss == 0;
+#endif
+}
+
+bool BloomFilter::insert(uint64_t hash) noexcept {
+    Block& block = blockFor(hash);
+#if defined(__AVX2__)
+    const auto [low, high] = detail::bloomMasks(static_cast<uint32_t>(hash));
+    auto*         words    = reinterpret_cast<__m256i*>(block.words.data());
+    const __m256i first    = _mm256_load_si256(words);
+    const __m256i second   = _mm256_load_si256(words + 1);
+    const bool    present  = _mm256_testc_si256(first, low) && _mm256_testc_si256(second, high);
+    _mm256_store_si256(words, _mm256_or_si256(first, low));
+    _mm256_store_si256(words + 1, _mm256_or_si256(second, high));
+    return !present;
+#else
+    const auto masks = detail::bloomMasks(static_cast<uint32_t>(hash));
+    uint64_t   miss  = 0;
+    for (size_t i = 0; i < masks.size(); ++i) {
+        miss           |= masks[i] & ~block.words[i];
+        block.words[i] |= masks[i];
+    }
+    return miss != 0;
+#endif
+}
+
+void BloomFilter::clear() noexcept { std::fill(mBlocks.begin(), mBlocks.end(), Block{}); }
+
+uint64_t BloomFilter::hash(const Endpoint& endpoint) noexcept {
+    return detail::splitMix64(EndpointHash{}(endpoint));
+}
+
+uint64_t BloomFilter::hash(std::string_view key) noexcept {
+    return detail::splitMix64(std::hash<std::string_view>{}(key));
+}
+
+} // namespace motdpe
\ No newline at end of file
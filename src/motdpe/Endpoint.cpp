@@ -0,0 +1,67 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/Endpoint.hpp"
+#include "detail/Socket.hpp"
+#include <algorithm>
+#include <format>
+
+namespace motdpe {
+
+std::optional<Endpoint> Endpoint::parse(std::string_view address, uint16_t port) {
+    detail::ensureSocketsInitialized();
+
+    const std::string text{address};
+    Endpoint          endpoint;
+    endpoint.port = port;
+    if (inet_pton(AF_INET, text.c_str(), endpoint.address.data()) == 1) return endpoint;
+    if (inet_pton(AF_INET6, text.c_str(), endpoint.address.data()) == 1) {
+        endpoint.ipv6 = true;
+        return endpoint;
+    }
+    return std::nullopt;
+}
+
+std::vector<Endpoint> Endpoint::resolve(std::string_view host, uint16_t port) {
+    if (auto numeric = parse(host, port)) return {*numeric};
+
+    addrinfo hints{};
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_protocol = IPPROTO_UDP;
+
+    addrinfo* res = nullptr;
+    if (const int status = getaddrinfo(std::string(host).c_str(), nullptr, &hints, &res); status != 0) {
+        throw detail::MotdException{std::format("DNS resolution failed: {}", detail::addrInfoError(status))};
+    }
+
+    detail::AddrInfoPtr   resPtr(res);
+    std::vector<Endpoint> endpoints;
+    for (const addrinfo* addr = res; addr != nullptr; addr = addr->ai_next) {
+        Endpoint endpoint;
+        if (!detail::fromSockaddr(addr->ai_addr, endpoint)) continue;
+        endpoint.port = port;
+        if (std::find(endpoints.begin(), endpoints.end(), endpoint) == endpoints.end()) endpoints.push_back(endpoint);
+    }
+    if (endpoints.empty()) throw detail::MotdException{std::format("No usable address for {}", host)};
+    return endpoints;
+}
+
+std::string Endpoint::addressString() const {
+    detail::ensureSocketsInitialized();
+
+    char buffer[INET6_ADDRSTRLEN]{};
+    inet_ntop(ipv6 ? AF_INET6 : AF_INET, address.data(), buffer, sizeof(buffer));
+    return buffer;
+}
+
+std::string Endpoint::toString() const {
+    if (ipv6) return std::format("[{}]:{}", addressString(), port);
+    return std::format("{}:{}", addressString(), port);
+}
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,225 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/Enrichment.hpp"
+#include "detail/Socket.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace motdpe {
+
+namespace detail {
+
+constexpr std::array<std::byte, 16> OFFLINE_MAGIC = {0x00_b, 0xFF_b, 0xFF_b, 0x00_b, 0xFE_b, 0xFE_b, 0xFE_b, 0xFE_b,
+                                                     0xFD_b, 0xFD_b, 0xFD_b, 0xFD_b, 0x12_b, 0x34_b, 0x56_b, 0x78_b};
+
+constexpr std::byte RAKNET_PROTOCOL_VERSION = 0x0B_b;
+
+// Probe sizes are full IP datagram sizes; the UDP payload is smaller by the IP and UDP headers.
+constexpr std::array<uint16_t, 4> MTU_LADDER = {1492, 1400, 1200, 576};
+
+constexpr size_t UDP_IPV4_OVERHEAD = 28;
+constexpr size_t UDP_IPV6_OVERHEAD = 48;
+
+SocketHandle openProbeSocket(const Endpoint& endpoint, bool dontFragment) {
+    ensureSocketsInitialized();
+    SocketHandle sock{socket(endpoint.ipv6 ? AF_INET6 : AF_INET, SOCK_DGRAM, IPPROTO_UDP)};
+    if (!sock || !dontFragment) return sock;
+
+#if defined(_WIN32)
+    const DWORD enabled = 1;
+    if (!endpoint.ipv6) {
+        setsockopt(sock, IPPROTO_IP, IP_DONTFRAGMENT, reinterpret_cast<const char*>(&enabled), sizeof(enabled));
+    }
+#elif defined(IP_MTU_DISCOVER) && defined(IP_PMTUDISC_DO)
+    if (endpoint.ipv6) {
+#if defined(IPV6_MTU_DISCOVER) && defined(IPV6_PMTUDISC_DO)
+        const int mode = IPV6_PMTUDISC_DO;
+        setsockopt(sock, IPPROTO_IPV6, IPV6_MTU_DISCOVER, &mode, sizeof(mode));
+#endif
+    } else {
+        const int mode = IP_PMTUDISC_DO;
+        setsockopt(sock, IPPROTO_IP, IP_MTU_DISCOVER, &mode, sizeof(mode));
+    }
+#endif
+    return sock;
+}
+
+bool sendPacket(SocketType sock, const Endpoint& endpoint, std::span<const std::byte> packet) {
+    sockaddr_storage addr{};
+    const socklen_t  addrLen = toSockaddr(endpoint, addr);
+    return sendto(
+               sock,
+               reinterpret_cast<const char*>(packet.data()),
+               static_cast<int>(packet.size()),
+               0,
+               reinterpret_cast<const sockaddr*>(&addr),
+               addrLen
+           )
+        != SOCKET_ERROR_VALUE;
+}
+
+// Receives datagrams from `endpoint` until one starts with `packetId` or the deadline passes.
+std::optional<size_t> receiveFrom(
+    SocketType                            sock,
+    const Endpoint&                       endpoint,
+    std::byte                             packetId,
+    std::span<std::byte>                  buffer,
+    std::chrono::steady_clock::time_point deadline
+) {
+    for (auto now = std::chrono::steady_clock::now(); now < deadline; now = std::chrono::steady_clock::now()) {
+        if (!waitReadable(sock, deadline - now)) continue;
+
+        sockaddr_storage fromAddr{};
+        socklen_t        fromLen = sizeof(fromAddr);
+        const int        recvLen = recvfrom(
+            sock,
+            reinterpret_cast<char*>(buffer.data()),
+            static_cast<int>(buffer.size()),
+            0,
+            reinterpret_cast<sockaddr*>(&fromAddr),
+            &fromLen
+        );
+        Endpoint from;
+        if (recvLen <= 0 || !fromSockaddr(reinterpret_cast<const sockaddr*>(&fromAddr), from) || from != endpoint) {
+            continue;
+        }
+        if (buffer[0] == packetId) return static_cast<size_t>(recvLen);
+    }
+    return std::nullopt;
+}
+
+// Splits a NUL-separated string list, stopping at an empty entry. Advances `data` past the terminator.
+std::vector<std::string_view> splitNulList(std::string_view& data) {
+    std::vector<std::string_view> items;
+    while (!data.empty()) {
+        const auto end  = data.find('\0');
+        const auto item = data.substr(0, end);
+        data            = end == std::string_view::npos ? std::string_view{} : data.substr(end + 1);
+        if (item.empty()) break;
+        items.push_back(item);
+    }
+    return items;
+}
+
+} // namespace detail
+
+std::optional<std::chrono::microseconds> pingRtt(const Endpoint& endpoint, std::chrono::milliseconds timeout) {
+    using namespace detail;
+
+    SocketHandle sock = openProbeSocket(endpoint, false);
+    if (!sock) return std::nullopt;
+
+    const auto     deadline = std::chrono::steady_clock::now() + timeout;
+    const uint64_t sentAt   = steadyMicros();
+    if (!sendPacket(sock, endpoint, makePing(sentAt))) return std::nullopt;
+
+    std::array<std::byte, 2048> buffer;
+    if (!receiveFrom(sock, endpoint, 0x1C_b, buffer, deadline)) return std::nullopt;
+    return std::chrono::microseconds{steadyMicros() - sentAt};
+}
+
+std::optional<QueryInfo> queryFullStat(const Endpoint& endpoint, std::chrono::milliseconds timeout) {
+    using namespace detail;
+
+    SocketHandle sock = openProbeSocket(endpoint, false);
+    if (!sock) return std::nullopt;
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    // The session id must survive the server masking every byte with 0x0F.
+    const uint32_t session = static_cast<uint32_t>(std::random_device{}()) & 0x0F0F0F0F;
+
+    std::array<std::byte, 7> handshake = {0xFE_b, 0xFD_b, 0x09_b};
+    for (size_t i = 0; i < 4; ++i) handshake[3 + i] = static_cast<std::byte>(session >> (24 - 8 * i));
+    if (!sendPacket(sock, endpoint, handshake)) return std::nullopt;
+
+    std::array<std::byte, 8192> buffer;
+    const auto                  challengeLen = receiveFrom(sock, endpoint, 0x09_b, buffer, deadline);
+    if (!challengeLen || *challengeLen <= 5) return std::nullopt;
+
+    std::string_view challengeText{reinterpret_cast<const char*>(buffer.data() + 5), *challengeLen - 5};
+    challengeText = challengeText.substr(0, challengeText.find('\0'));
+    int32_t challenge = 0;
+    if (std::from_chars(challengeText.data(), challengeText.data() + challengeText.size(), challenge).ec
+        != std::errc{}) {
+        return std::nullopt;
+    }
+
+    std::array<std::byte, 15> request       = {0xFE_b, 0xFD_b, 0x00_b};
+    const auto                challengeBits = static_cast<uint32_t>(challenge);
+    for (size_t i = 0; i < 4; ++i) request[3 + i] = handshake[3 + i];
+    for (size_t i = 0; i < 4; ++i) request[7 + i] = static_cast<std::byte>(challengeBits >> (24 - 8 * i));
+    if (!sendPacket(sock, endpoint, request)) return std::nullopt;
+
+    const auto statLen = receiveFrom(sock, endpoint, 0x00_b, buffer, deadline);
+    // Packet id, session id and the constant "splitnum\0\x80\0" padding precede the key/value section.
+    constexpr size_t STAT_HEADER = 5 + 11;
+    if (!statLen || *statLen <= STAT_HEADER) return std::nullopt;
+
+    std::string_view data{reinterpret_cast<const char*>(buffer.data() + STAT_HEADER), *statLen - STAT_HEADER};
+    QueryInfo        info;
+    const auto       pairs = detail::splitNulList(data);
+    for (size_t i = 0; i + 1 < pairs.size(); i += 2) info.values.emplace_back(pairs[i], pairs[i + 1]);
+    if (pairs.size() % 2 != 0) info.values.emplace_back(pairs.back(), std::string{});
+
+    // "\x01player_\0\0" separates the player list.
+    constexpr std::string_view PLAYER_HEADER{"\x01player_\0\0", 10};
+    if (const auto pos = data.find(PLAYER_HEADER); pos != std::string_view::npos) {
+        data = data.substr(pos + PLAYER_HEADER.size());
+        for (const auto name : detail::splitNulList(data)) info.players.emplace_back(name);
+    }
+    return info;
+}
+
+std::optional<uint16_t> probeMtu(const Endpoint& endpoint, std::chrono::milliseconds timeout) {
+    using namespace detail;
+
+    SocketHandle sock = openProbeSocket(endpoint, true);
+    if (!sock) return std::nullopt;
+
+    std::array<std::byte, 2048> buffer;
+    std::vector<std::byte>      packet;
+    const size_t                overhead = endpoint.ipv6 ? UDP_IPV6_OVERHEAD : UDP_IPV4_OVERHEAD;
+    for (const uint16_t mtu : MTU_LADDER) {
+        // OpenConnectionRequest1: id, offline magic, protocol version, zero padding up to the probed size.
+        packet.assign(mtu - overhead, std::byte{0});
+        packet[0] = 0x05_b;
+        std::copy(OFFLINE_MAGIC.begin(), OFFLINE_MAGIC.end(), packet.begin() + 1);
+        packet[17] = RAKNET_PROTOCOL_VERSION;
+        if (!sendPacket(sock, endpoint, packet)) continue; // EMSGSIZE: larger than the local path MTU.
+
+        // OpenConnectionReply1: id, magic, server GUID, security flag, [cookie,] MTU.
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        const auto replyLen = receiveFrom(sock, endpoint, 0x06_b, buffer, deadline);
+        if (!replyLen || *replyLen < 28) continue;
+
+        const size_t mtuOffset = buffer[25] != 0x00_b ? 30 : 26;
+        if (*replyLen < mtuOffset + 2) continue;
+        const auto reported = static_cast<uint16_t>(
+            static_cast<uint16_t>(buffer[mtuOffset]) << 8 | static_cast<uint16_t>(buffer[mtuOffset + 1])
+        );
+        return std::min(reported, mtu);
+    }
+    return std::nullopt;
+}
+
+Enrichment enrich(const Endpoint& endpoint, const EnrichmentOptions& options) {
+    Enrichment result;
+    for (uint32_t i = 0; i < options.rttSamples; ++i) {
+        if (auto rtt = pingRtt(endpoint, options.timeout)) result.rttSamples.push_back(*rtt);
+    }
+    if (options.queryPlayers) result.query = queryFullStat(endpoint, options.timeout);
+    if (options.probeMtu) result.mtu = probeMtu(endpoint, options.timeout);
+    return result;
+}
+
+} // namespace motdpe
\ No newline at end of file
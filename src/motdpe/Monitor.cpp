@@ -0,0 +1,737 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/Monitor.hpp"
+#include "motdpe/Alerts.hpp"
+#include "motdpe/ServerIndex.hpp"
+#include "motdpe/StatusServer.hpp"
+#include "motdpe/TextIndex.hpp"
+#include "detail/ChangeLog.hpp"
+#include "detail/FairQueue.hpp"
+#include "detail/MonitorSnapshot.hpp"
+#include "detail/Permutation.hpp"
+#include "detail/PingEngine.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace motdpe {
+
+namespace detail {
+
+constexpr size_t PRIORITY_LANES = 3;
+
+// Upper bound on one scheduler sleep, so that target changes and stop() are picked up promptly.
+constexpr std::chrono::milliseconds MONITOR_MAX_WAIT{20};
+
+// Retry delay for a target whose endpoint is already being pinged on behalf of another target.
+constexpr std::chrono::milliseconds DUPLICATE_RETRY{100};
+
+// Snapshots are taken and restored in different processes, so their timestamps use the wall clock.
+inline int64_t wallClockMs() {
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+}
+
+class MonitorScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit MonitorScheduler(MonitorOptions options) : mOptions(std::move(options)) {}
+
+    ~MonitorScheduler() { stop(); }
+
+    uint64_t add(MonitorTarget target) {
+        const Endpoint  endpoint = Endpoint::resolve(target.host, target.port).front();
+        std::lock_guard lock{mWriterMutex};
+        const uint64_t  id = mNextId++;
+        mConfigs.emplace(id, target);
+        publishTarget(id, ResolvedTarget{std::move(target), endpoint});
+        return id;
+    }
+
+    bool remove(uint64_t id) {
+        std::lock_guard lock{mWriterMutex};
+        if (!mConfigs.erase(id)) return false;
+        publishTarget(id, std::nullopt);
+        return true;
+    }
+
+    bool update(uint64_t id, MonitorTarget target) {
+        {
+            std::lock_guard lock{mWriterMutex};
+            const auto      it = mConfigs.find(id);
+            if (it == mConfigs.end()) return false;
+            if (it->second.host == target.host && it->second.port == target.port) {
+                it->second = target;
+                publishTarget(id, ResolvedTarget{std::move(target), std::nullopt});
+                return true;
+            }
+        }
+
+        // A new address is resolved outside the writer lock, like add().
+        const Endpoint  endpoint = Endpoint::resolve(target.host, target.port).front();
+        std::lock_guard lock{mWriterMutex};
+        const auto      it = mConfigs.find(id);
+        if (it == mConfigs.end()) return false;
+        it->second = target;
+        publishTarget(id, ResolvedTarget{std::move(target), endpoint});
+        return true;
+    }
+
+    void setTenantWeight(std::string_view tenant, uint32_t weight) {
+        std::lock_guard lock{mWriterMutex};
+        mWeights.insert_or_assign(std::string{tenant}, weight);
+        ChangeBatch batch;
+        batch.weights.emplace_back(std::string{tenant}, weight);
+        mChanges.publish(std::move(batch));
+    }
+
+    [[nodiscard]] size_t size() const {
+        std::lock_guard lock{mWriterMutex};
+        return mConfigs.size();
+    }
+
+    void start(Monitor::Callback callback) {
+        if (mThread.joinable()) return;
+        mStopping.store(false, std::memory_order_relaxed);
+        if (mOptions.index || mOptions.text) {
+            mIndexStopping.store(false, std::memory_order_relaxed);
+            mIndexer = std::thread{[this] { runIndexer(); }};
+        }
+        mThread = std::thread{[this, callback = std::move(callback)] { run(callback); }};
+    }
+
+    void stop() {
+        if (!mThread.joinable()) return;
+        mStopping.store(true, std::memory_order_relaxed);
+        mThread.join();
+        // The scheduler has published its last batch, which the indexing thread applies before it exits.
+        if (mIndexer.joinable()) {
+            mIndexStopping.store(true, std::memory_order_release);
+            mIndexSignal.fetch_add(1, std::memory_order_release);
+            mIndexSignal.notify_one();
+            mIndexer.join();
+        }
+    }
+
+    [[nodiscard]] bool running() const noexcept { return mThread.joinable(); }
+
+    void save(const std::filesystem::path& path) {
+        if (running()) throw MotdException{"Cannot save a running monitor"};
+        std::lock_guard lock{mWriterMutex};
+        // The scheduler thread is joined, so this thread may act as the reader of the change log.
+        const auto now = Clock::now();
+        while (const ChangeBatch* batch = mChanges.next()) apply(*batch, now);
+        flushIndex();
+
+        std::string strings;
+        const auto  intern = [&](std::string_view text) {
+            if (strings.size() + text.size() > UINT32_MAX) throw MotdException{"Monitor snapshot is too large"};
+            const SnapshotString ref{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(text.size())};
+            strings.append(text);
+            return ref;
+        };
+        const auto offset = [&](Clock::time_point time) {
+            if (time == Clock::time_point{}) return SNAPSHOT_NO_TIME;
+            return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(time - now).count());
+        };
+
+        std::vector<uint64_t> ids;
+        ids.reserve(mTargets.size());
+        for (const auto& [id, target] : mTargets) ids.push_back(id);
+        std::ranges::sort(ids);
+
+        std::vector<SnapshotTarget> targets;
+        targets.reserve(ids.size());
+        for (const uint64_t id : ids) {
+            const Target&  target = mTargets.at(id);
+            SnapshotTarget record{};
+            record.id         = id;
+            record.address    = target.endpoint.address;
+            record.port       = target.endpoint.port;
+            record.ipv6       = target.endpoint.ipv6;
+            record.priority   = static_cast<uint8_t>(target.config.priority);
+            record.failures   = target.failures;
+            record.intervalMs = target.config.interval.count();
+            record.srttUs     = target.rtt.srtt().count();
+            record.rttvarUs   = target.rtt.rttvar().count();
+            record.rttBackoff = target.rtt.backoff();
+            record.dueMs      = offset(target.due);
+            record.previousMs = offset(target.previous);
+            record.host       = intern(target.config.host);
+            record.tenant     = intern(target.config.tenant);
+            record.motd       = intern(target.lastMotd);
+            targets.push_back(record);
+        }
+
+        std::vector<SnapshotWeight> weights;
+        for (const auto& [tenant, weight] : mWeights) weights.push_back(SnapshotWeight{intern(tenant), weight, 0});
+
+        SnapshotHeader header{};
+        header.magic       = SNAPSHOT_MAGIC;
+        header.version     = SNAPSHOT_VERSION;
+        header.byteOrder   = SNAPSHOT_BYTE_ORDER;
+        header.targetSize  = sizeof(SnapshotTarget);
+        header.weightSize  = sizeof(SnapshotWeight);
+        header.targetCount = targets.size();
+        header.weightCount = weights.size();
+        header.stringsSize = strings.size();
+        header.nextId      = mNextId;
+        header.savedAt     = wallClockMs();
+
+        // Written next to the target and renamed over it, so a crash never leaves a truncated snapshot behind.
+        auto temporary = path;
+        temporary += ".tmp";
+        {
+            std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+            if (!file) throw MotdException{std::format("Failed to create snapshot file: {}", temporary.string())};
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(targets.data()), targets.size() * sizeof(SnapshotTarget));
+            file.write(reinterpret_cast<const char*>(weights.data()), weights.size() * sizeof(SnapshotWeight));
+            file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+            if (!file.flush()) {
+                throw MotdException{std::format("Failed to write snapshot file: {}", temporary.string())};
+            }
+        }
+        std::filesystem::rename(temporary, path);
+    }
+
+    size_t restore(const std::filesystem::path& path) {
+        if (running()) throw MotdException{"Cannot restore into a running monitor"};
+
+        std::ifstream file{path, std::ios::binary | std::ios::ate};
+        if (!file) throw MotdException{std::format("Failed to open snapshot file: {}", path.string())};
+        std::vector<char> image(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        if (!file.read(image.data(), static_cast<std::streamsize>(image.size()))) {
+            throw MotdException{std::format("Failed to read snapshot file: {}", path.string())};
+        }
+
+        const auto invalid = [&](std::string_view reason) {
+            return MotdException{std::format("Invalid snapshot file {}: {}", path.string(), reason)};
+        };
+
+        SnapshotHeader header;
+        if (image.size() < sizeof(header)) throw invalid("truncated header");
+        std::memcpy(&header, image.data(), sizeof(header));
+        if (header.magic != SNAPSHOT_MAGIC) throw invalid("bad magic");
+        if (header.byteOrder != SNAPSHOT_BYTE_ORDER) throw invalid("byte order mismatch");
+        if (header.version != SNAPSHOT_VERSION || header.targetSize != sizeof(SnapshotTarget)
+            || header.weightSize != sizeof(SnapshotWeight)) {
+            throw invalid(std::format("unsupported version {}", header.version));
+        }
+
+        // Each section is checked against what is left of the body, so no sum of header fields can wrap around.
+        size_t remaining = image.size() - sizeof(header);
+        if (header.targetCount > remaining / sizeof(SnapshotTarget)) throw invalid("size mismatch");
+        remaining -= header.targetCount * sizeof(SnapshotTarget);
+        if (header.weightCount > remaining / sizeof(SnapshotWeight)) throw invalid("size mismatch");
+        remaining -= header.weightCount * sizeof(SnapshotWeight);
+        if (header.stringsSize != remaining) throw invalid("size mismatch");
+        const char* targets = image.data() + sizeof(header);
+        const char* weights = targets + header.targetCount * sizeof(SnapshotTarget);
+        const char* strings = weights + header.weightCount * sizeof(SnapshotWeight);
+        const auto  text    = [&](SnapshotString ref) {
+            if (ref.offset > header.stringsSize || ref.size > header.stringsSize - ref.offset) {
+                throw invalid("string out of range");
+            }
+            return std::string_view{strings + ref.offset, ref.size};
+        };
+
+        std::lock_guard lock{mWriterMutex};
+        if (mNextId != 1) throw MotdException{"Snapshots can only be restored into a monitor without targets"};
+        const auto now = Clock::now();
+        while (const ChangeBatch* batch = mChanges.next()) apply(*batch, now);
+
+        for (size_t i = 0; i < header.weightCount; ++i) {
+            SnapshotWeight record;
+            std::memcpy(&record, weights + i * sizeof(record), sizeof(record));
+            std::string tenant{text(record.tenant)};
+            mReady.setWeight(tenantIndex(tenant), record.weight);
+            mWeights.insert_or_assign(std::move(tenant), record.weight);
+        }
+
+        // Offsets are shifted by the downtime and then advanced by whole periods, so every target keeps its phase and
+        // the restored schedule is as spread out as the saved one.
+        const auto downtime = std::chrono::milliseconds{std::max<int64_t>(wallClockMs() - header.savedAt, 0)};
+
+        uint64_t nextId = std::max<uint64_t>(header.nextId, 1);
+        for (size_t i = 0; i < header.targetCount; ++i) {
+            SnapshotTarget record;
+            std::memcpy(&record, targets + i * sizeof(record), sizeof(record));
+            if (record.priority >= PRIORITY_LANES || record.intervalMs < 0 || mConfigs.contains(record.id)) {
+                throw invalid(std::format("bad target record {}", i));
+            }
+
+            MonitorTarget config{
+                std::string{text(record.host)},
+                record.port,
+                std::chrono::milliseconds{record.intervalMs},
+                static_cast<Priority>(record.priority),
+                std::string{text(record.tenant)}
+            };
+            Endpoint endpoint;
+            endpoint.address = record.address;
+            endpoint.port    = record.port;
+            endpoint.ipv6    = record.ipv6 != 0;
+
+            Target target{config, endpoint, tenantIndex(config.tenant), mOptions.rtt};
+            target.rtt.restore(
+                std::chrono::microseconds{record.srttUs},
+                std::chrono::microseconds{record.rttvarUs},
+                record.rttBackoff
+            );
+            target.failures = record.failures;
+            target.lastMotd = text(record.motd);
+            if (mOptions.payloads && !target.lastMotd.empty()) {
+                target.lastPayload = mOptions.payloads->intern(target.lastMotd);
+            }
+
+            const auto step = period(target);
+            if (record.dueMs == SNAPSHOT_NO_TIME) {
+                target.due = now + phase(record.id, config.interval);
+            } else {
+                target.due = now + std::chrono::milliseconds{record.dueMs} - downtime;
+                if (target.due < now) target.due += ((now - target.due) / step + 1) * step;
+            }
+            if (record.previousMs != SNAPSHOT_NO_TIME) target.previous = target.due - step;
+
+            if (const auto pong = parsePong(target.lastMotd)) {
+                publishStatus(record.id, target, &*pong, target.rtt.srtt(), header.savedAt);
+                indexStatus(record.id, target, &*pong);
+            }
+            mDue.emplace(target.due, record.id);
+            mTargets.emplace(record.id, std::move(target));
+            mConfigs.emplace(record.id, std::move(config));
+            nextId = std::max(nextId, record.id + 1);
+        }
+        mNextId = nextId;
+        flushIndex();
+        return header.targetCount;
+    }
+
+private:
+    struct ResolvedTarget {
+        MonitorTarget config;
+        // Empty when an update keeps the address of the target.
+        std::optional<Endpoint> endpoint;
+    };
+
+    struct TargetChange {
+        uint64_t id;
+        // Empty for a removal.
+        std::optional<ResolvedTarget> target;
+    };
+
+    struct ChangeBatch {
+        std::vector<TargetChange>                     targets;
+        std::vector<std::pair<std::string, uint32_t>> weights;
+    };
+
+    // Index operation recorded by the scheduler; the indexing thread applies them in order.
+    struct IndexChange {
+        uint64_t            id;
+        std::optional<Pong> pong;
+        bool                up    = false;
+        bool                erase = false;
+    };
+
+    using IndexBatch = std::vector<IndexChange>;
+
+    enum class Stage : uint8_t {
+        Waiting,
+        Ready,
+        InFlight,
+    };
+
+    struct Target {
+        Target(MonitorTarget target, const Endpoint& address, uint32_t tenantIndex, const RttOptions& options)
+        : config(std::move(target)),
+          endpoint(address),
+          tenant(tenantIndex),
+          rtt(options) {}
+
+        MonitorTarget     config;
+        Endpoint          endpoint;
+        uint32_t          tenant;
+        RttEstimator      rtt;
+        uint32_t          failures = 0;
+        Stage             stage    = Stage::Waiting;
+        Clock::time_point due;
+        // Due time of the previous probe, empty before the first one; schedule changes keep the phase from it.
+        Clock::time_point previous;
+        // While in flight: when the probe gives up, and when its ping is resent next.
+        Clock::time_point deadline;
+        Clock::time_point hedgeAt;
+        // Raw payload of the last pong, kept for snapshots, and its id in MonitorOptions::payloads.
+        std::string lastMotd;
+        PayloadId   lastPayload;
+    };
+
+    using Due      = std::pair<Clock::time_point, uint64_t>;
+    using DueQueue = std::priority_queue<Due, std::vector<Due>, std::greater<>>;
+
+    void publishTarget(uint64_t id, std::optional<ResolvedTarget> target) {
+        ChangeBatch batch;
+        batch.targets.push_back(TargetChange{id, std::move(target)});
+        mChanges.publish(std::move(batch));
+    }
+
+    void run(const Monitor::Callback& callback) {
+        PingEngine engine{mOptions.transport, mOptions.rate};
+
+        while (!mStopping.load(std::memory_order_relaxed)) {
+            auto now = Clock::now();
+            while (const ChangeBatch* batch = mChanges.next()) apply(*batch, now);
+
+            while (!mDue.empty() && mDue.top().first <= now) {
+                const auto [due, id] = mDue.top();
+                mDue.pop();
+                // Entries of removed or rescheduled targets are left in the heap and skipped here.
+                const auto it = mTargets.find(id);
+                if (it == mTargets.end() || it->second.stage != Stage::Waiting || it->second.due != due) continue;
+                it->second.stage = Stage::Ready;
+                mReady.push(static_cast<size_t>(it->second.config.priority), it->second.tenant, id);
+            }
+
+            // Resends of probes in flight go first, so a single lost datagram does not take a target down.
+            while (!mHedges.empty() && mHedges.top().first <= now) {
+                const auto [at, id] = mHedges.top();
+                const auto it       = mTargets.find(id);
+                if (it == mTargets.end() || it->second.stage != Stage::InFlight || it->second.hedgeAt != at) {
+                    mHedges.pop();
+                    continue;
+                }
+
+                using enum PingEngine::SendResult;
+                const auto result = engine.resend(it->second.endpoint, id);
+                if (result == RateLimited || result == WouldBlock) break;
+                mHedges.pop();
+                // A failed resend leaves the probe to its remaining pings and deadline.
+                if (result == Sent) scheduleHedge(id, it->second, now);
+            }
+
+            while (const auto id = mReady.peek()) {
+                const auto it = mTargets.find(*id);
+                if (it == mTargets.end()) {
+                    mReady.pop();
+                    continue;
+                }
+
+                using enum PingEngine::SendResult;
+                Target&    target   = it->second;
+                const auto deadline = now + target.rtt.timeout();
+                const auto result   = engine.send(target.endpoint, *id, deadline);
+                if (result == RateLimited || result == WouldBlock) break;
+
+                mReady.pop();
+                if (result == Duplicate) {
+                    target.stage = Stage::Waiting;
+                    target.due   = now + DUPLICATE_RETRY;
+                    mDue.emplace(target.due, *id);
+                } else if (result == Failed) {
+                    onFailure(*id, target, now, callback);
+                } else {
+                    target.stage    = Stage::InFlight;
+                    target.deadline = deadline;
+                    scheduleHedge(*id, target, now);
+                }
+            }
+
+            while (auto pong = engine.receive()) {
+                const auto it = mTargets.find(pong->token);
+                if (it == mTargets.end()) continue;
+
+                Target&    target  = it->second;
+                const bool changed = target.failures != 0 || target.lastMotd != pong->motd;
+                target.rtt.addSample(pong->rtt);
+                target.failures = 0;
+                if (changed) {
+                    target.lastMotd.assign(pong->motd);
+                    // Unchanged payloads keep their id, so the store is only consulted on a change.
+                    if (mOptions.payloads) target.lastPayload = mOptions.payloads->intern(pong->motd);
+                }
+                reschedule(pong->token, target, now);
+
+                auto parsed = parsePong(pong->motd);
+                publishStatus(pong->token, target, parsed ? &*parsed : nullptr, pong->rtt, wallClockMs());
+                if (changed) indexStatus(pong->token, target, parsed ? &*parsed : nullptr);
+                if (callback || mOptions.alerts) {
+                    deliver(
+                        MonitorEvent{
+                            pong->token,
+                            target.config,
+                            target.endpoint,
+                            pong->motd,
+                            target.lastPayload,
+                            std::move(parsed),
+                            pong->rtt,
+                            0,
+                            changed
+                        },
+                        now,
+                        callback
+                    );
+                }
+            }
+
+            now = Clock::now();
+            while (auto expired = engine.expire(now)) {
+                const auto it = mTargets.find(expired->token);
+                if (it != mTargets.end()) onFailure(expired->token, it->second, now, callback);
+            }
+            if (mOptions.alerts) mOptions.alerts->advance(now);
+
+            auto until = std::min(now + MONITOR_MAX_WAIT, engine.nextDeadline().value_or(Clock::time_point::max()));
+            if (!mDue.empty()) until = std::min(until, mDue.top().first);
+            if (!mReady.empty()) until = std::min(until, engine.nextSendTime());
+            if (!mHedges.empty()) {
+                until = std::min(until, mHedges.top().first > now ? mHedges.top().first : engine.nextSendTime());
+            }
+            flushIndex();
+            engine.wait(until);
+        }
+        flushIndex();
+
+        // Pings still outstanding die with the engine. Their targets go back on the heap at their past due time, so
+        // the next start() probes them at once and keeps their phase; targets left in mReady are sent from there.
+        for (auto& [id, target] : mTargets) {
+            if (target.stage != Stage::InFlight) continue;
+            target.stage = Stage::Waiting;
+            mDue.emplace(target.due, id);
+        }
+        mHedges = DueQueue{};
+    }
+
+    void apply(const ChangeBatch& batch, Clock::time_point now) {
+        for (const auto& [tenant, weight] : batch.weights) mReady.setWeight(tenantIndex(tenant), weight);
+        for (const TargetChange& change : batch.targets) {
+            if (!change.target) {
+                mTargets.erase(change.id);
+                if (mOptions.status) mOptions.status->erase(change.id);
+                if (mOptions.server) mOptions.server->invalidate(change.id);
+                if (mOptions.alerts) mOptions.alerts->forget(change.id);
+                if (mOptions.index || mOptions.text) {
+                    mIndexBatch.push_back(IndexChange{change.id, std::nullopt, false, true});
+                }
+                continue;
+            }
+
+            const ResolvedTarget& resolved = *change.target;
+            const auto            tenant   = tenantIndex(resolved.config.tenant);
+            const auto            it       = mTargets.find(change.id);
+            if (it == mTargets.end()) {
+                Target target{resolved.config, *resolved.endpoint, tenant, mOptions.rtt};
+                target.due = now + phase(change.id, target.config.interval);
+                mDue.emplace(target.due, change.id);
+                mTargets.emplace(change.id, std::move(target));
+                continue;
+            }
+
+            // Updates keep the RTT estimate and failure count; a probe in progress completes under the old settings.
+            Target& target = it->second;
+            target.config  = resolved.config;
+            target.tenant  = tenant;
+            if (resolved.endpoint) target.endpoint = *resolved.endpoint;
+            if (target.stage != Stage::Waiting) continue;
+
+            target.due = target.previous == Clock::time_point{} ? now + phase(change.id, target.config.interval)
+                                                                : std::max(now, target.previous + period(target));
+            mDue.emplace(target.due, change.id);
+        }
+    }
+
+    // Spread first probes uniformly over the interval instead of bursting every target at once.
+    static std::chrono::milliseconds phase(uint64_t id, std::chrono::milliseconds interval) {
+        interval = std::max(interval, std::chrono::milliseconds{1});
+        return std::chrono::milliseconds{splitMix64(id) % static_cast<uint64_t>(interval.count())};
+    }
+
+    // Dead targets back off exponentially so they do not eat the budget of live ones.
+    std::chrono::milliseconds period(const Target& target) const {
+        const auto interval = std::max(target.config.interval, std::chrono::milliseconds{1});
+        if (target.failures == 0) return interval;
+        return std::min<std::chrono::milliseconds>(
+            interval * (uint64_t{1} << std::min<uint32_t>(target.failures - 1, 20)),
+            std::max(mOptions.maxBackoff, interval)
+        );
+    }
+
+    uint32_t tenantIndex(const std::string& tenant) {
+        return mTenants.try_emplace(tenant, static_cast<uint32_t>(mTenants.size())).first->second;
+    }
+
+    void onFailure(uint64_t id, Target& target, Clock::time_point now, const Monitor::Callback& callback) {
+        target.rtt.onTimeout();
+        ++target.failures;
+        reschedule(id, target, now);
+        publishStatus(id, target, nullptr, {}, wallClockMs());
+        if (target.failures == 1) indexStatus(id, target, nullptr);
+        if (callback || mOptions.alerts) {
+            // Only the first failure after a pong (or of a target never heard from) is a change.
+            const bool changed = target.failures == 1;
+            deliver(
+                MonitorEvent{id, target.config, target.endpoint, {}, {}, std::nullopt, {}, target.failures, changed},
+                now,
+                callback
+            );
+        }
+    }
+
+    void deliver(const MonitorEvent& event, Clock::time_point now, const Monitor::Callback& callback) {
+        if (mOptions.alerts) mOptions.alerts->process(event, now);
+        if (callback) callback(event);
+    }
+
+    // The pong fields of the previous record are kept while a target fails.
+    void publishStatus(
+        uint64_t                  id,
+        const Target&             target,
+        const Pong*               pong,
+        std::chrono::microseconds rtt,
+        int64_t                   updatedAt
+    ) {
+        if (!mOptions.status) return;
+        StatusRecord record = mOptions.status->read(id).value_or(StatusRecord{});
+        record.id           = id;
+        record.updatedAt    = updatedAt;
+        record.failures     = target.failures;
+        if (pong) {
+            record.rttUs = static_cast<uint32_t>(std::min<int64_t>(rtt.count(), UINT32_MAX));
+            record.setPong(*pong);
+        }
+        // A full table turns the record away and counts it in StatusTable::rejected(); the next probe retries.
+        mOptions.status->publish(record);
+        if (mOptions.server) mOptions.server->invalidate(id);
+    }
+
+    // Called for changed results only; a pong that fails to parse leaves the indexed attributes as they were. The
+    // indexes lock on update, so the scheduler only records the change and flushIndex() hands it off.
+    void indexStatus(uint64_t id, const Target& target, const Pong* pong) {
+        if (!mOptions.index && !mOptions.text) return;
+        mIndexBatch.push_back(IndexChange{id, pong ? std::optional{*pong} : std::nullopt, target.failures == 0, false});
+    }
+
+    // Publishes the changes of one scheduler pass to the indexing thread, or applies them in place while the monitor
+    // is stopped and the calling thread owns the scheduler state.
+    void flushIndex() {
+        if (mIndexBatch.empty()) return;
+        if (!mIndexer.joinable()) {
+            applyIndex(mIndexBatch);
+            mIndexBatch.clear();
+            return;
+        }
+        mIndexLog.publish(std::exchange(mIndexBatch, {}));
+        mIndexSignal.fetch_add(1, std::memory_order_release);
+        mIndexSignal.notify_one();
+    }
+
+    // Indexing thread: the only reader of mIndexLog while the monitor runs.
+    void runIndexer() {
+        for (;;) {
+            // Read before draining, so that a stop request is only honoured once every batch published ahead of it
+            // has been applied.
+            const bool     stopping = mIndexStopping.load(std::memory_order_acquire);
+            const uint32_t signal   = mIndexSignal.load(std::memory_order_acquire);
+            while (const IndexBatch* batch = mIndexLog.next()) applyIndex(*batch);
+            if (stopping) return;
+            mIndexSignal.wait(signal, std::memory_order_acquire);
+        }
+    }
+
+    void applyIndex(const IndexBatch& batch) {
+        for (const IndexChange& change : batch) {
+            if (change.erase) {
+                if (mOptions.index) mOptions.index->erase(change.id);
+                if (mOptions.text) mOptions.text->erase(change.id);
+                continue;
+            }
+            if (mOptions.text && change.pong) mOptions.text->update(change.id, *change.pong);
+            if (!mOptions.index) continue;
+            if (change.pong) mOptions.index->update(change.id, *change.pong);
+            // update() marks the target up; a pong that arrives for a failing target leaves it down.
+            if (!change.pong || !change.up) mOptions.index->setUp(change.id, change.up);
+        }
+    }
+
+    // Hedged retransmits follow the RTO the timeout is made of; none is sent once the probe would give up first.
+    void scheduleHedge(uint64_t id, Target& target, Clock::time_point now) {
+        target.hedgeAt = now + target.rtt.hedgeDelay();
+        if (target.hedgeAt < target.deadline) mHedges.emplace(target.hedgeAt, id);
+    }
+
+    // Next probe one period after the previous due time, keeping the target's phase; missed periods are skipped.
+    void reschedule(uint64_t id, Target& target, Clock::time_point now) {
+        const auto step  = period(target);
+        target.previous  = target.due;
+        target.due      += step;
+        if (target.due <= now) target.due += ((now - target.due) / step + 1) * step;
+        target.stage = Stage::Waiting;
+        mDue.emplace(target.due, id);
+    }
+
+    MonitorOptions    mOptions;
+    std::thread       mThread;
+    std::atomic<bool> mStopping{false};
+
+    // Writer side: the authoritative target list, serialized by a mutex the scheduler thread never takes.
+    mutable std::mutex                          mWriterMutex;
+    std::unordered_map<uint64_t, MonitorTarget> mConfigs;
+    std::unordered_map<std::string, uint32_t>   mWeights;
+    uint64_t                                    mNextId = 1;
+    ChangeLog<ChangeBatch>                      mChanges;
+
+    // Index changes flow from the scheduler to a thread of their own, so the scheduler never waits on an index lock.
+    std::thread           mIndexer;
+    std::atomic<bool>     mIndexStopping{false};
+    std::atomic<uint32_t> mIndexSignal{0};
+    ChangeLog<IndexBatch> mIndexLog;
+
+    // Owned by the scheduler thread.
+    std::unordered_map<uint64_t, Target>      mTargets;
+    std::unordered_map<std::string, uint32_t> mTenants;
+    DueQueue                                  mDue;
+    DueQueue                                  mHedges;
+    FairQueue<PRIORITY_LANES>                 mReady;
+    IndexBatch                                mIndexBatch;
+};
+
+} // namespace detail
+
+Monitor::Monitor(MonitorOptions options) : mScheduler(std::make_unique<detail::MonitorScheduler>(std::move(options))) {}
+
+Monitor::~Monitor() = default;
+
+uint64_t Monitor::add(MonitorTarget target) { return mScheduler->add(std::move(target)); }
+
+bool Monitor::remove(uint64_t id) { return mScheduler->remove(id); }
+
+bool Monitor::update(uint64_t id, MonitorTarget target) { return mScheduler->update(id, std::move(target)); }
+
+size_t Monitor::size() const { return mScheduler->size(); }
+
+void Monitor::save(const std::filesystem::path& path) { mScheduler->save(path); }
+
+size_t Monitor::restore(const std::filesystem::path& path) { return mScheduler->restore(path); }
+
+void Monitor::setTenantWeight(std::string_view tenant, uint32_t weight) { mScheduler->setTenantWeight(tenant, weight); }
+
+void Monitor::start(Callback callback) { mScheduler->start(std::move(callback)); }
+
+void Monitor::stop() { mScheduler->stop(); }
+
+bool Monitor::running() const noexcept { return mScheduler->running(); }
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,196 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/PayloadStore.hpp"
+#include "detail/Json.hpp"
+#include "detail/Xxh3.hpp"
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace motdpe {
+
+namespace detail {
+
+constexpr size_t PAYLOAD_ID_DIGITS = 32;
+
+class PayloadStoreImpl {
+public:
+    explicit PayloadStoreImpl(std::shared_ptr<SinkWriter> log) : mLog(std::move(log)) {}
+
+    PayloadId intern(std::string_view payload) {
+        const PayloadId hash = PayloadStore::hash(payload);
+        mInterned.fetch_add(1, std::memory_order_relaxed);
+        mInternedBytes.fetch_add(payload.size(), std::memory_order_relaxed);
+        {
+            std::shared_lock lock{mMutex};
+            if (const auto [id, found] = locate(hash, payload); found) {
+                mHits.fetch_add(1, std::memory_order_relaxed);
+                return id;
+            }
+        }
+
+        std::string line;
+        PayloadId   id;
+        {
+            std::unique_lock lock{mMutex};
+            // Looked up again: another thread may have stored the payload since the shared lookup.
+            const auto [free, found] = locate(hash, payload);
+            id                       = free;
+            if (found) {
+                mHits.fetch_add(1, std::memory_order_relaxed);
+                return id;
+            }
+            mPayloads.emplace(id, payload);
+            if (id != hash) ++mCollisions;
+            mBytes += payload.size();
+            if (mLog) {
+                line += "{\"id\":\"";
+                line += id.toString();
+                line += "\",\"payload\":";
+                appendJsonString(line, payload);
+                line += "}\n";
+            }
+        }
+        // Outside the lock, so a saturated log only holds up the thread that found a new payload. A failing log must
+        // not take down the monitor or scan that interns; the payload stays stored and the failure is counted.
+        if (mLog) {
+            try {
+                mLog->write(line);
+            } catch (...) {
+                mLogErrors.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        return id;
+    }
+
+    std::optional<std::string_view> find(const PayloadId& id) const {
+        std::shared_lock lock{mMutex};
+        const auto       it = mPayloads.find(id);
+        if (it == mPayloads.end()) return std::nullopt;
+        // Map nodes do not move, so the view survives other insertions.
+        return std::string_view{it->second};
+    }
+
+    bool erase(const PayloadId& id) {
+        std::unique_lock lock{mMutex};
+        const auto       it = mPayloads.find(id);
+        if (it == mPayloads.end()) return false;
+        mBytes -= it->second.size();
+        mPayloads.erase(it);
+        return true;
+    }
+
+    void clear() {
+        std::unique_lock lock{mMutex};
+        mPayloads.clear();
+        mBytes = 0;
+    }
+
+    size_t size() const {
+        std::shared_lock lock{mMutex};
+        return mPayloads.size();
+    }
+
+    PayloadStoreStats stats() const {
+        std::shared_lock lock{mMutex};
+        return PayloadStoreStats{
+            mPayloads.size(),
+            mBytes,
+            mInterned.load(std::memory_order_relaxed),
+            mHits.load(std::memory_order_relaxed),
+            mInternedBytes.load(std::memory_order_relaxed),
+            mCollisions,
+            mLogErrors.load(std::memory_order_relaxed),
+        };
+    }
+
+private:
+    // Id under which `payload` is stored, or the id to store it under: its hash, unless a different payload already
+    // took that, in which case the following ids are probed.
+    std::pair<PayloadId, bool> locate(PayloadId id, std::string_view payload) const {
+        for (auto it = mPayloads.find(id); it != mPayloads.end(); it = mPayloads.find(id)) {
+            if (it->second == payload) return {id, true};
+            if (++id.low == 0) ++id.high;
+            if (!id) id.low = 1;
+        }
+        return {id, false};
+    }
+
+    std::shared_ptr<SinkWriter>                               mLog;
+    mutable std::shared_mutex                                 mMutex;
+    std::unordered_map<PayloadId, std::string, PayloadIdHash> mPayloads;
+    uint64_t                                                  mBytes      = 0;
+    uint64_t                                                  mCollisions = 0;
+    std::atomic<uint64_t>                                     mInterned{0};
+    std::atomic<uint64_t>                                     mHits{0};
+    std::atomic<uint64_t>                                     mInternedBytes{0};
+    std::atomic<uint64_t>                                     mLogErrors{0};
+};
+
+} // namespace detail
+
+std::string PayloadId::toString() const {
+    constexpr std::string_view HEX = "0123456789abcdef";
+    std::string                text(detail::PAYLOAD_ID_DIGITS, '0');
+    for (size_t i = 0; i < 16; ++i) {
+        text[15 - i] = HEX[(high >> (4 * i)) & 0xF];
+        text[31 - i] = HEX[(low >> (4 * i)) & 0xF];
+    }
+    return text;
+}
+
+std::optional<PayloadId> PayloadId::parse(std::string_view text) noexcept {
+    if (text.size() != detail::PAYLOAD_ID_DIGITS) return std::nullopt;
+    PayloadId id;
+    for (size_t i = 0; i < detail::PAYLOAD_ID_DIGITS; ++i) {
+        const char c = text[i];
+        uint64_t   digit;
+        if (c >= '0' && c <= '9') {
+            digit = static_cast<uint64_t>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            digit = static_cast<uint64_t>(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            digit = static_cast<uint64_t>(c - 'A' + 10);
+        } else {
+            return std::nullopt;
+        }
+        uint64_t& half = i < 16 ? id.high : id.low;
+        half           = half << 4 | digit;
+    }
+    return id;
+}
+
+PayloadStore::PayloadStore() : PayloadStore(nullptr) {}
+
+PayloadStore::PayloadStore(std::shared_ptr<SinkWriter> log)
+: mImpl(std::make_unique<detail::PayloadStoreImpl>(std::move(log))) {}
+
+PayloadStore::~PayloadStore() = default;
+
+PayloadId PayloadStore::hash(std::string_view payload) noexcept {
+    const auto hash = detail::xxh3Hash128({reinterpret_cast<const uint8_t*>(payload.data()), payload.size()});
+    return PayloadId{hash.low, hash.high};
+}
+
+PayloadId PayloadStore::intern(std::string_view payload) { return mImpl->intern(payload); }
+
+std::optional<std::string_view> PayloadStore::find(const PayloadId& id) const { return mImpl->find(id); }
+
+bool PayloadStore::contains(const PayloadId& id) const { return mImpl->find(id).has_value(); }
+
+bool PayloadStore::erase(const PayloadId& id) { return mImpl->erase(id); }
+
+void PayloadStore::clear() { mImpl->clear(); }
+
+size_t PayloadStore::size() const { return mImpl->size(); }
+
+PayloadStoreStats PayloadStore::stats() const { return mImpl->stats(); }
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,188 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/PingContext.hpp"
+#include "detail/Socket.hpp"
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace motdpe {
+
+namespace detail {
+
+// Poll timeout while nothing is pending; submissions wake the thread anyway.
+constexpr std::chrono::hours IDLE_WAIT{1};
+
+class PingContextImpl {
+public:
+    explicit PingContextImpl(const ChannelOptions& options) : mChannel(options), mWake("ping context") {
+        mThread = std::thread{[this] { run(); }};
+    }
+
+    ~PingContextImpl() {
+        {
+            std::lock_guard lock{mMutex};
+            mStopping = true;
+        }
+        mWake.wake();
+        mThread.join();
+
+        // Completions may submit to this context again; submit() turns those away now that mStopping is set, so the
+        // lists are taken out before any completion runs.
+        PingOperationBase* queued;
+        {
+            std::lock_guard lock{mMutex};
+            queued = std::exchange(mQueued, nullptr);
+            mQueuedTail = nullptr;
+        }
+        for (PingOperationBase* operation = queued; operation;) {
+            PingOperationBase& current = *std::exchange(operation, operation->next);
+            current.complete(current, nullptr);
+        }
+        for (PingOperationBase* operation = std::exchange(mLive, nullptr); operation;) {
+            PingOperationBase& current = *std::exchange(operation, operation->next);
+            current.complete(current, nullptr);
+        }
+    }
+
+    PingContextImpl(const PingContextImpl&)            = delete;
+    PingContextImpl& operator=(const PingContextImpl&) = delete;
+
+    void submit(PingOperationBase& operation) {
+        operation.next = nullptr;
+        bool accepted;
+        {
+            std::lock_guard lock{mMutex};
+            accepted = !mStopping;
+            if (accepted) {
+                (mQueuedTail ? mQueuedTail->next : mQueued) = &operation;
+                mQueuedTail                                 = &operation;
+            }
+        }
+        if (accepted) return mWake.wake();
+        // The context is shutting down: submissions complete as cancelled instead of queueing work nobody will run.
+        operation.complete(operation, nullptr);
+    }
+
+    // The flag is what the I/O thread acts on, so a request for an operation that has not started yet, or that
+    // completes in the meantime, needs no lookup and leaves nothing behind.
+    void cancel(PingOperationBase& operation) {
+        operation.cancelRequested.store(true, std::memory_order_release);
+        {
+            std::lock_guard lock{mMutex};
+            if (mStopping) return;
+            mCancelPending = true;
+        }
+        mWake.wake();
+    }
+
+private:
+    void run() {
+        std::vector<PollFd> fds;
+        for (const NativeSocket sock : mChannel.sockets()) {
+            fds.push_back(PollFd{static_cast<SocketType>(sock), POLL_READ_EVENT, 0});
+        }
+        fds.push_back(PollFd{mWake.handle(), POLL_READ_EVENT, 0});
+
+        std::vector<NativeSocket> readable;
+        for (;;) {
+            PingOperationBase* queued;
+            bool               cancelling;
+            {
+                std::lock_guard lock{mMutex};
+                if (mStopping) return;
+                queued      = std::exchange(mQueued, nullptr);
+                mQueuedTail = nullptr;
+                cancelling  = std::exchange(mCancelPending, false);
+            }
+            for (PingOperationBase* operation = queued; operation;) start(*std::exchange(operation, operation->next));
+            if (cancelling) stopRequested();
+
+            const auto until = mChannel.nextTimeout();
+            const auto now   = std::chrono::steady_clock::now();
+            pollSockets(fds.data(), fds.size(), until ? std::max(*until - now, {}) : IDLE_WAIT);
+
+            readable.clear();
+            for (size_t i = 0; i + 1 < fds.size(); ++i) {
+                if (fds[i].revents != 0) readable.push_back(static_cast<NativeSocket>(fds[i].fd));
+            }
+            if (fds.back().revents != 0) mWake.drain();
+            mChannel.process(readable);
+        }
+    }
+
+    void start(PingOperationBase& operation) {
+        if (operation.cancelRequested.load(std::memory_order_acquire)) {
+            operation.complete(operation, nullptr);
+            return;
+        }
+        if (!operation.ping) {
+            const BatchResult arrived;
+            operation.complete(operation, &arrived);
+            return;
+        }
+        const auto onResult = [this, &operation](const BatchResult& result) {
+            unlink(operation);
+            operation.complete(operation, &result);
+        };
+        operation.query = mChannel.query(operation.endpoint, operation.timeout, onResult);
+        link(operation);
+    }
+
+    // One pass over the outstanding operations per wake-up, however many stop requests arrived. Completions run
+    // inline and may request more stops, which set the flag again for the next pass.
+    void stopRequested() {
+        for (PingOperationBase* operation = mLive; operation;) {
+            PingOperationBase& current = *std::exchange(operation, operation->next);
+            if (!current.cancelRequested.load(std::memory_order_acquire)) continue;
+            unlink(current);
+            mChannel.cancel(current.query);
+            current.complete(current, nullptr);
+        }
+    }
+
+    void link(PingOperationBase& operation) noexcept {
+        operation.prev = nullptr;
+        operation.next = mLive;
+        if (mLive) mLive->prev = &operation;
+        mLive = &operation;
+    }
+
+    void unlink(PingOperationBase& operation) noexcept {
+        (operation.prev ? operation.prev->next : mLive) = operation.next;
+        if (operation.next) operation.next->prev = operation.prev;
+    }
+
+    QueryChannel mChannel;
+    WakeSocket   mWake;
+    std::mutex   mMutex;
+    // Submitted but not yet started, oldest first.
+    PingOperationBase* mQueued        = nullptr;
+    PingOperationBase* mQueuedTail    = nullptr;
+    bool               mCancelPending = false;
+    bool               mStopping      = false;
+    // Outstanding queries; only the I/O thread touches this list while it runs.
+    PingOperationBase* mLive = nullptr;
+    std::thread        mThread;
+};
+
+} // namespace detail
+
+PingContext::PingContext(const ChannelOptions& options)
+: mImpl(std::make_unique<detail::PingContextImpl>(options)),
+  mDefaultTimeout(options.timeout) {}
+
+PingContext::~PingContext() = default;
+
+void PingContext::submit(detail::PingOperationBase& operation) { mImpl->submit(operation); }
+
+void PingContext::cancel(detail::PingOperationBase& operation) { mImpl->cancel(operation); }
+
+} // namespace motdpe
\ No newline at end of file
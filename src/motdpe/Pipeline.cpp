@@ -0,0 +1,228 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/Pipeline.hpp"
+#include "detail/MpmcQueue.hpp"
+#include "detail/Query.hpp"
+#include "detail/Socket.hpp"
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <thread>
+
+namespace motdpe {
+
+namespace detail {
+
+// Spin briefly, then yield, then sleep: keeps hand-off latency low under load without burning idle cores.
+class Backoff {
+public:
+    void wait() noexcept {
+        if (mRound < SPIN_ROUNDS) {
+            ++mRound;
+        } else if (mRound < SPIN_ROUNDS + YIELD_ROUNDS) {
+            ++mRound;
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds{100});
+        }
+    }
+
+    void reset() noexcept { mRound = 0; }
+
+private:
+    static constexpr unsigned SPIN_ROUNDS  = 64;
+    static constexpr unsigned YIELD_ROUNDS = 64;
+
+    unsigned mRound = 0;
+};
+
+struct PipelineStage {
+    PipelineStage(StageOptions stageOptions, Pipeline::StageFunction stageFunction)
+    : options(std::move(stageOptions)),
+      function(std::move(stageFunction)),
+      queue(options.queueCapacity) {}
+
+    StageOptions             options;
+    Pipeline::StageFunction  function;
+    MpmcQueue<PipelineItem>  queue;
+    PipelineStage*           next = nullptr;
+    std::vector<std::thread> workers;
+
+    std::atomic<bool>     inputClosed{false};
+    std::atomic<size_t>   activeWorkers{0};
+    std::atomic<uint64_t> processed{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<int64_t>  busyNanos{0};
+    std::atomic<int64_t>  blockedNanos{0};
+
+    void run() {
+        using Clock = std::chrono::steady_clock;
+
+        PipelineItem item;
+        Backoff      backoff;
+        for (;;) {
+            if (!queue.tryPop(item)) {
+                if (!inputClosed.load(std::memory_order_acquire)) {
+                    backoff.wait();
+                    continue;
+                }
+                // Upstream finished all pushes before closing, so one more attempt cannot miss an item.
+                if (!queue.tryPop(item)) break;
+            }
+            backoff.reset();
+
+            const auto start = Clock::now();
+            bool       keep  = true;
+            try {
+                keep = function(item);
+            } catch (const std::exception& e) {
+                item.error = e.what();
+            } catch (...) {
+                item.error = "Unknown exception";
+            }
+            const auto done = Clock::now();
+            const std::chrono::nanoseconds busy = done - start;
+            busyNanos.fetch_add(busy.count(), std::memory_order_relaxed);
+            processed.fetch_add(1, std::memory_order_relaxed);
+
+            if (!keep) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+            } else if (next) {
+                Backoff pushBackoff;
+                while (!next->queue.tryPush(item)) pushBackoff.wait();
+                const std::chrono::nanoseconds blocked = Clock::now() - done;
+                blockedNanos.fetch_add(blocked.count(), std::memory_order_relaxed);
+            }
+            item = PipelineItem{};
+        }
+
+        // The last worker out closes the next stage's input.
+        if (activeWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1 && next) {
+            next->inputClosed.store(true, std::memory_order_release);
+        }
+    }
+};
+
+} // namespace detail
+
+Pipeline::Pipeline() = default;
+
+Pipeline::~Pipeline() { close(); }
+
+Pipeline& Pipeline::addStage(StageOptions options, StageFunction function) {
+    if (mRunning) throw detail::MotdException{"Cannot add a stage to a running pipeline"};
+    if (options.name.empty()) options.name = std::format("stage{}", mStages.size());
+    options.threads = std::max<size_t>(options.threads, 1);
+
+    mStages.push_back(std::make_unique<detail::PipelineStage>(std::move(options), std::move(function)));
+    if (mStages.size() > 1) mStages[mStages.size() - 2]->next = mStages.back().get();
+    return *this;
+}
+
+void Pipeline::start() {
+    if (mRunning || mStages.empty()) return;
+    mRunning = true;
+    mStarted = std::chrono::steady_clock::now();
+    for (auto& stage : mStages) {
+        stage->activeWorkers.store(stage->options.threads, std::memory_order_relaxed);
+        for (size_t i = 0; i < stage->options.threads; ++i) {
+            stage->workers.emplace_back([raw = stage.get()] { raw->run(); });
+        }
+    }
+}
+
+void Pipeline::push(PipelineItem item) {
+    detail::Backoff backoff;
+    while (!tryPush(item)) backoff.wait();
+}
+
+bool Pipeline::tryPush(PipelineItem& item) {
+    if (!mRunning) throw detail::MotdException{"Pipeline is not running"};
+    return mStages.front()->queue.tryPush(item);
+}
+
+void Pipeline::close() {
+    if (!mRunning) return;
+    mStages.front()->inputClosed.store(true, std::memory_order_release);
+    for (auto& stage : mStages) {
+        for (auto& worker : stage->workers) worker.join();
+        stage->workers.clear();
+    }
+    mRunning = false;
+}
+
+std::vector<StageStats> Pipeline::stats() const {
+    const auto elapsed = std::chrono::steady_clock::now() - mStarted;
+
+    std::vector<StageStats> result;
+    result.reserve(mStages.size());
+    for (const auto& stage : mStages) {
+        const auto   threads  = static_cast<double>(stage->options.threads);
+        const double capacity = static_cast<double>(std::chrono::nanoseconds{elapsed}.count()) * threads;
+        StageStats   stats;
+        stats.name      = stage->options.name;
+        stats.threads   = stage->options.threads;
+        stats.processed = stage->processed.load(std::memory_order_relaxed);
+        stats.dropped   = stage->dropped.load(std::memory_order_relaxed);
+        stats.queued    = stage->queue.size();
+        stats.capacity  = stage->queue.capacity();
+        if (capacity > 0.0) {
+            stats.utilization = static_cast<double>(stage->busyNanos.load(std::memory_order_relaxed)) / capacity;
+            stats.blocked     = static_cast<double>(stage->blockedNanos.load(std::memory_order_relaxed)) / capacity;
+        }
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
+namespace stages {
+
+Pipeline::StageFunction resolve() {
+    return [](PipelineItem& item) {
+        if (!item.error.empty() || item.endpoint) return true;
+        item.endpoint = Endpoint::resolve(item.host, item.port).front();
+        return true;
+    };
+}
+
+Pipeline::StageFunction ping(std::chrono::milliseconds timeout) {
+    return [timeout](PipelineItem& item) {
+        if (!item.error.empty() || !item.endpoint) return true;
+        auto reply = detail::QueryEndpointImpl(*item.endpoint, timeout, timeout);
+        item.motd  = std::move(reply.motd);
+        item.rtt   = reply.rtt;
+        return true;
+    };
+}
+
+Pipeline::StageFunction parse(bool dropInvalid) {
+    return [dropInvalid](PipelineItem& item) {
+        if (!item.error.empty() || item.motd.empty()) return true;
+        item.pong = parsePong(item.motd);
+        return item.pong.has_value() || !dropInvalid;
+    };
+}
+
+Pipeline::StageFunction enrich(EnrichmentOptions options) {
+    return [options = std::move(options)](PipelineItem& item) {
+        if (!item.error.empty() || !item.endpoint || item.motd.empty()) return true;
+        item.enrichment = motdpe::enrich(*item.endpoint, options);
+        return true;
+    };
+}
+
+Pipeline::StageFunction sink(std::function<void(const PipelineItem&)> sink) {
+    return [sink = std::move(sink)](PipelineItem& item) {
+        sink(item);
+        return true;
+    };
+}
+
+} // namespace stages
+
+} // namespace motdpe
\ No newline at end of file
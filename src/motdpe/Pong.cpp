@@ -0,0 +1,71 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/Pong.hpp"
+#include "detail/PongFields.hpp"
+#include "detail/Socket.hpp"
+#include <array>
+
+namespace motdpe {
+
+namespace detail {
+
+// "§" in UTF-8.
+constexpr std::string_view SECTION_SIGN = "\xC2\xA7";
+
+} // namespace detail
+
+std::optional<Pong> parsePong(std::string_view payload) {
+    detail::PongFields fields;
+    if (detail::splitPongFields(payload, fields) < detail::PONG_REQUIRED_COUNT) return std::nullopt;
+
+    Pong pong;
+    pong.edition = fields[0];
+    pong.motd    = fields[1];
+    detail::parseNumber(fields[2], pong.protocol);
+    pong.version = fields[3];
+    detail::parseNumber(fields[4], pong.online);
+    detail::parseNumber(fields[5], pong.max);
+    pong.serverId = fields[6];
+    pong.subMotd  = fields[7];
+    pong.gameMode = fields[8];
+    detail::parseNumber(fields[9], pong.gameModeId);
+    detail::parseNumber(fields[10], pong.portV4);
+    detail::parseNumber(fields[11], pong.portV6);
+    return pong;
+}
+
+std::array<std::byte, 33> makePingPacket(uint64_t timestamp) noexcept { return detail::makePing(timestamp); }
+
+std::optional<std::string_view> pongPayload(std::span<const std::byte> packet, uint64_t* timestamp) noexcept {
+    if (!detail::isPong(packet.data(), packet.size())) return std::nullopt;
+    if (timestamp) *timestamp = detail::pongTimestamp(packet.data());
+    return std::string_view{
+        reinterpret_cast<const char*>(packet.data() + detail::PONG_HEADER_SIZE),
+        packet.size() - detail::PONG_HEADER_SIZE
+    };
+}
+
+std::string stripFormatting(std::string_view text) {
+    std::string result;
+    result.reserve(text.size());
+    while (!text.empty()) {
+        const auto pos = text.find(detail::SECTION_SIGN);
+        result.append(text.substr(0, pos));
+        if (pos == std::string_view::npos) break;
+
+        text = text.substr(pos + detail::SECTION_SIGN.size());
+        if (text.empty()) break;
+        // Skip the code character, which may itself be a multi-byte UTF-8 sequence.
+        size_t skip = 1;
+        while (skip < text.size() && (static_cast<unsigned char>(text[skip]) & 0xC0) == 0x80) ++skip;
+        text = text.substr(skip);
+    }
+    return result;
+}
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,146 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/QueryChannel.hpp"
+#include "detail/PingEngine.hpp"
+#include <algorithm>
+#include <format>
+#include <iterator>
+
+namespace motdpe {
+
+namespace detail {
+
+// Retry delay after the kernel's send buffer filled up; the channel does not ask the host loop for writability.
+constexpr std::chrono::milliseconds SEND_RETRY{1};
+
+} // namespace detail
+
+QueryChannel::QueryChannel(const ChannelOptions& options)
+: mOptions(options),
+  mEngine(std::make_unique<detail::PingEngine>(options.transport, options.rate)) {
+    for (const auto sock : mEngine->sockets()) mSockets.push_back(static_cast<NativeSocket>(sock));
+}
+
+QueryChannel::~QueryChannel() = default;
+
+uint64_t QueryChannel::query(const Endpoint& endpoint, Callback callback) {
+    return query(endpoint, mOptions.timeout, std::move(callback));
+}
+
+uint64_t QueryChannel::query(const Endpoint& endpoint, std::chrono::milliseconds timeout, Callback callback) {
+    const uint64_t id  = mNextId++;
+    const auto     now = Clock::now();
+    mQueued.push_back(Query{id, endpoint, now + timeout, std::move(callback)});
+    flush(now);
+    return id;
+}
+
+bool QueryChannel::cancel(uint64_t id) {
+    // A cancelled in-flight ping stays with the engine until its pong or deadline and is ignored then.
+    if (mInFlight.erase(id) != 0) return true;
+    if (const auto it = std::ranges::find(mQueued, id, &Query::id); it != mQueued.end()) {
+        mQueued.erase(it);
+        return true;
+    }
+    if (const auto it = std::ranges::find(mFailed, id, [](const auto& failed) { return failed.first.id; });
+        it != mFailed.end()) {
+        mFailed.erase(it);
+        return true;
+    }
+    return false;
+}
+
+std::vector<NativeSocket> QueryChannel::sockets() const { return mSockets; }
+
+std::optional<QueryChannel::Clock::time_point> QueryChannel::nextTimeout() {
+    if (!mFailed.empty()) return Clock::now();
+
+    auto next = mEngine->nextDeadline();
+    if (mRetryAt) next = std::min(next.value_or(Clock::time_point::max()), *mRetryAt);
+    for (const Query& query : mQueued) next = std::min(next.value_or(Clock::time_point::max()), query.deadline);
+    return next;
+}
+
+void QueryChannel::process(std::span<const NativeSocket> readable, Clock::time_point now) {
+    const bool ours = std::ranges::any_of(readable, [this](NativeSocket sock) {
+        return std::ranges::find(mSockets, sock) != mSockets.end();
+    });
+    if (ours) {
+        while (auto pong = mEngine->receive()) {
+            const auto it = mInFlight.find(pong->token);
+            if (it == mInFlight.end()) continue;
+
+            Query query = std::move(it->second);
+            mInFlight.erase(it);
+            if (query.callback) query.callback(BatchResult{std::string{pong->motd}, pong->rtt, {}});
+        }
+    }
+
+    while (auto expired = mEngine->expire(now)) {
+        const auto it = mInFlight.find(expired->token);
+        if (it == mInFlight.end()) continue;
+
+        Query query = std::move(it->second);
+        mInFlight.erase(it);
+        if (query.callback) {
+            query.callback(BatchResult{
+                std::nullopt,
+                {},
+                std::format("Timed out waiting for pong from {}", expired->endpoint.toString())
+            });
+        }
+    }
+
+    flush(now);
+
+    // Callbacks may queue or cancel queries, so deliver from a detached list.
+    auto failed = std::exchange(mFailed, {});
+    for (auto& [query, result] : failed) {
+        if (query.callback) query.callback(result);
+    }
+}
+
+void QueryChannel::flush(Clock::time_point now) {
+    using enum detail::PingEngine::SendResult;
+
+    // Queries to an endpoint that already has a ping in flight wait for it to finish.
+    std::vector<Query> waiting;
+    mRetryAt.reset();
+    while (!mQueued.empty()) {
+        Query& query = mQueued.front();
+        if (query.deadline <= now) {
+            auto error = std::format("Timed out waiting for pong from {}", query.endpoint.toString());
+            mFailed.emplace_back(std::move(query), BatchResult{std::nullopt, {}, std::move(error)});
+            mQueued.pop_front();
+            continue;
+        }
+
+        const auto result = mEngine->send(query.endpoint, query.id, query.deadline);
+        if (result == RateLimited) {
+            mRetryAt = mEngine->nextSendTime();
+            break;
+        }
+        if (result == WouldBlock) {
+            mRetryAt = now + detail::SEND_RETRY;
+            break;
+        }
+
+        if (result == Sent) {
+            mInFlight.emplace(query.id, std::move(query));
+        } else if (result == Duplicate) {
+            waiting.push_back(std::move(query));
+        } else {
+            auto error = std::format("Send failed for {}", query.endpoint.toString());
+            mFailed.emplace_back(std::move(query), BatchResult{std::nullopt, {}, std::move(error)});
+        }
+        mQueued.pop_front();
+    }
+    mQueued.insert(mQueued.begin(), std::make_move_iterator(waiting.begin()), std::make_move_iterator(waiting.end()));
+}
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,112 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/RangeFilter.hpp"
+#include "detail/Poptrie.hpp"
+#include "detail/Socket.hpp"
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <string>
+
+namespace motdpe {
+
+namespace detail {
+
+PrefixKey toPrefixKey(const Endpoint& endpoint) noexcept {
+    PrefixKey key;
+    for (size_t i = 0; i < 8; ++i) key.hi = (key.hi << 8) | endpoint.address[i];
+    if (endpoint.ipv6) {
+        for (size_t i = 8; i < 16; ++i) key.lo = (key.lo << 8) | endpoint.address[i];
+    }
+    return key;
+}
+
+std::string_view trim(std::string_view text) noexcept {
+    const auto first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string_view::npos) return {};
+    const auto last = text.find_last_not_of(" \t\r\n");
+    return text.substr(first, last - first + 1);
+}
+
+} // namespace detail
+
+RangeFilter::RangeFilter() : mV4(std::make_unique<detail::Poptrie>()), mV6(std::make_unique<detail::Poptrie>()) {}
+
+RangeFilter::~RangeFilter() = default;
+
+RangeFilter::RangeFilter(RangeFilter&&) noexcept = default;
+
+RangeFilter& RangeFilter::operator=(RangeFilter&&) noexcept = default;
+
+void RangeFilter::add(std::string_view cidr, RangeAction action) {
+    const auto slash   = cidr.find('/');
+    const auto address = Endpoint::parse(cidr.substr(0, slash), 0);
+    if (!address) throw detail::MotdException{std::format("Invalid prefix: {}", cidr)};
+
+    const unsigned width  = address->ipv6 ? 128 : 32;
+    unsigned       length = width;
+    if (slash != std::string_view::npos) {
+        const auto text = cidr.substr(slash + 1);
+        if (std::from_chars(text.data(), text.data() + text.size(), length).ec != std::errc{} || length > width) {
+            throw detail::MotdException{std::format("Invalid prefix length: {}", cidr)};
+        }
+    }
+
+    (address->ipv6 ? mV6 : mV4)->insert(detail::toPrefixKey(*address), length, static_cast<uint8_t>(action));
+    if (action == RangeAction::Allow) mHasAllow = true;
+}
+
+void RangeFilter::loadFile(const std::filesystem::path& path, RangeAction defaultAction) {
+    std::ifstream file{path};
+    if (!file) throw detail::MotdException{std::format("Failed to open range file: {}", path.string())};
+
+    std::string line;
+    size_t      lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::string_view text = line;
+        if (const auto comment = text.find('#'); comment != std::string_view::npos) text = text.substr(0, comment);
+        text = detail::trim(text);
+        if (text.empty()) continue;
+
+        RangeAction action = defaultAction;
+        if (const auto space = text.find_first_of(" \t"); space != std::string_view::npos) {
+            const auto keyword = text.substr(0, space);
+            if (keyword == "allow") {
+                action = RangeAction::Allow;
+            } else if (keyword == "exclude" || keyword == "deny") {
+                action = RangeAction::Exclude;
+            } else {
+                throw detail::MotdException{
+                    std::format("{}:{}: unknown action '{}'", path.string(), lineNumber, keyword)
+                };
+            }
+            text = detail::trim(text.substr(space));
+        }
+        add(text, action);
+    }
+    build();
+}
+
+void RangeFilter::build() {
+    mV4->build();
+    mV6->build();
+}
+
+RangeAction RangeFilter::lookup(const Endpoint& endpoint) const noexcept {
+    return static_cast<RangeAction>((endpoint.ipv6 ? mV6 : mV4)->lookup(detail::toPrefixKey(endpoint)));
+}
+
+bool RangeFilter::permits(const Endpoint& endpoint) const noexcept {
+    const RangeAction action = lookup(endpoint);
+    return action == RangeAction::Allow || (action == RangeAction::None && !mHasAllow);
+}
+
+size_t RangeFilter::size() const noexcept { return mV4->prefixCount() + mV6->prefixCount(); }
+
+} // namespace motdpe
\ No newline at end of file
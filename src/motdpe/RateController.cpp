@@ -0,0 +1,145 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/RateController.hpp"
+#include "detail/Socket.hpp"
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+namespace motdpe {
+
+namespace {
+
+constexpr double BASELINE_GAIN = 0.125;
+
+// The rate is clamped into [minRate, maxRate], divided by when pacing and cut by multiplicativeDecrease, and windows
+// are stepped through one by one, so each of these bounds is what keeps the controller well-defined.
+const RateControllerOptions& validated(const RateControllerOptions& options) {
+    if (!(options.minRate > 0.0 && options.minRate <= options.maxRate)) {
+        throw detail::MotdException{
+            std::format("Invalid rate bounds: minRate {} and maxRate {}", options.minRate, options.maxRate)
+        };
+    }
+    if (!(options.multiplicativeDecrease > 0.0 && options.multiplicativeDecrease < 1.0)) {
+        throw detail::MotdException{std::format("Invalid multiplicative decrease: {}", options.multiplicativeDecrease)};
+    }
+    if (options.window <= std::chrono::milliseconds::zero()) {
+        throw detail::MotdException{std::format("Invalid rate window: {}ms", options.window.count())};
+    }
+    return options;
+}
+
+} // namespace
+
+RateController::RateController(const RateControllerOptions& options, Clock::time_point now)
+: mOptions(validated(options)),
+  mRate(std::clamp(options.initialRate, options.minRate, options.maxRate)),
+  mLastRefill(now),
+  mWindowEnd(now + options.window) {}
+
+size_t RateController::acquire(Clock::time_point now, size_t wanted) {
+    advance(now);
+    const double elapsed = std::chrono::duration<double>(now - mLastRefill).count();
+    const double depth   = std::max(1.0, mRate * std::chrono::duration<double>(mOptions.burst).count());
+    mTokens              = std::min(depth, mTokens + elapsed * mRate);
+    mLastRefill          = now;
+
+    const auto granted = std::min(wanted, static_cast<size_t>(mTokens));
+    mTokens           -= static_cast<double>(granted);
+    return granted;
+}
+
+RateController::Clock::time_point RateController::nextSendTime() const noexcept {
+    if (mTokens >= 1.0) return mLastRefill;
+    const auto wait = std::chrono::duration<double>((1.0 - mTokens) / mRate);
+    return mLastRefill + std::chrono::ceil<Clock::duration>(wait);
+}
+
+void RateController::onResponse(std::chrono::microseconds rtt, Clock::time_point now) {
+    advance(now);
+    ++mWindowResponses;
+    mWindowRttSum += rtt.count();
+    mWindowMinRtt  = std::min<int64_t>(mWindowMinRtt, rtt.count());
+}
+
+void RateController::onTimeout(Clock::time_point now) {
+    advance(now);
+    ++mWindowTimeouts;
+}
+
+void RateController::onCongestion(Clock::time_point now) {
+    advance(now);
+    if (now >= mHoldUntil) decrease(now);
+}
+
+std::chrono::microseconds RateController::baseRtt() const noexcept {
+    int64_t base = mWindowMinRtt;
+    for (const int64_t rtt : mWindowMinRtts) base = std::min(base, rtt);
+    return std::chrono::microseconds{base == INT64_MAX ? 0 : base};
+}
+
+void RateController::advance(Clock::time_point now) {
+    while (now >= mWindowEnd) {
+        closeWindow(mWindowEnd);
+        mWindowEnd += mOptions.window;
+        // Skip idle gaps in one step instead of closing every empty window.
+        if (now - mWindowEnd > mOptions.window * 4) mWindowEnd = now + mOptions.window;
+    }
+}
+
+void RateController::closeWindow(Clock::time_point now) {
+    const auto baseRtt = this->baseRtt().count();
+
+    if (mWindowMinRtt != INT64_MAX) {
+        mWindowMinRtts.push_back(mWindowMinRtt);
+        if (mWindowMinRtts.size() > mOptions.baseRttWindows) mWindowMinRtts.pop_front();
+    }
+    mHistory.push_back({mWindowResponses, mWindowResponses + mWindowTimeouts});
+    if (mHistory.size() > std::max<uint32_t>(mOptions.lossWindows, 1)) mHistory.pop_front();
+
+    uint64_t responses = 0;
+    uint64_t resolved  = 0;
+    for (const auto& [windowResponses, windowResolved] : mHistory) {
+        responses += windowResponses;
+        resolved  += windowResolved;
+    }
+
+    if (resolved >= mOptions.minSamples && now >= mHoldUntil) {
+        const double ratio = static_cast<double>(responses) / static_cast<double>(resolved);
+        // Scans see sparse responses, so the drop must also exceed two standard deviations of the expected count.
+        const double expected = mBaselineRatio * static_cast<double>(resolved);
+        const bool   lossy    = mBaselineRatio > 0.0
+                         && static_cast<double>(responses)
+                                < expected * (1.0 - mOptions.lossTolerance) - 2.0 * std::sqrt(expected);
+        const bool inflated = mWindowResponses > 0 && baseRtt > 0
+                           && static_cast<double>(mWindowRttSum) / static_cast<double>(mWindowResponses)
+                                  > static_cast<double>(baseRtt) * mOptions.rttInflation;
+
+        if (lossy || inflated) {
+            decrease(now);
+        } else {
+            // The baseline only learns from clean windows so that sustained loss cannot lower the bar.
+            mBaselineRatio = mBaselineRatio < 0.0 ? ratio : mBaselineRatio + (ratio - mBaselineRatio) * BASELINE_GAIN;
+            mRate          = std::min(mOptions.maxRate, mRate + mOptions.additiveIncrease);
+        }
+    }
+
+    mWindowResponses = 0;
+    mWindowTimeouts  = 0;
+    mWindowRttSum    = 0;
+    mWindowMinRtt    = INT64_MAX;
+}
+
+void RateController::decrease(Clock::time_point now) {
+    mRate      = std::max(mOptions.minRate, mRate * mOptions.multiplicativeDecrease);
+    mTokens    = std::min(mTokens, 1.0);
+    mHoldUntil = now + mOptions.decreaseHold;
+    mHistory.clear();
+}
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,123 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/RttEstimator.hpp"
+#include <algorithm>
+#include <format>
+
+namespace motdpe {
+
+namespace {
+
+constexpr uint32_t MAX_BACKOFF = 6;
+
+std::string makeKey(std::string_view host, uint16_t port) { return std::format("{}:{}", host, port); }
+
+} // namespace
+
+void RttEstimator::addSample(std::chrono::microseconds rtt) noexcept {
+    rtt = std::max(rtt, std::chrono::microseconds{1});
+    if (!mHasSample) {
+        mSrtt      = rtt;
+        mRttvar    = rtt / 2;
+        mHasSample = true;
+    } else {
+        const auto delta = rtt > mSrtt ? rtt - mSrtt : mSrtt - rtt;
+        mRttvar          = (mRttvar * 3 + delta) / 4;
+        mSrtt            = (mSrtt * 7 + rtt) / 8;
+    }
+    mBackoff = 0;
+}
+
+void RttEstimator::onTimeout() noexcept {
+    if (mBackoff < MAX_BACKOFF) ++mBackoff;
+}
+
+void RttEstimator::restore(
+    std::chrono::microseconds srtt,
+    std::chrono::microseconds rttvar,
+    uint32_t                  backoff
+) noexcept {
+    mHasSample = srtt.count() > 0;
+    mSrtt      = mHasSample ? srtt : std::chrono::microseconds{0};
+    mRttvar    = mHasSample ? std::max(rttvar, std::chrono::microseconds{0}) : std::chrono::microseconds{0};
+    mBackoff   = std::min(backoff, MAX_BACKOFF);
+}
+
+std::chrono::microseconds RttEstimator::rto() const noexcept {
+    const std::chrono::microseconds maxTimeout = mOptions.maxTimeout;
+    if (!mHasSample) return maxTimeout;
+    const auto base = std::max<std::chrono::microseconds>(mSrtt + 4 * mRttvar, mOptions.minRto);
+    return std::min(base * (1 << mBackoff), maxTimeout);
+}
+
+std::chrono::milliseconds RttEstimator::hedgeDelay() const noexcept {
+    if (!mHasSample) return std::min(mOptions.initialHedge, mOptions.maxTimeout);
+    return std::chrono::ceil<std::chrono::milliseconds>(rto());
+}
+
+std::chrono::milliseconds RttEstimator::timeout() const noexcept {
+    if (!mHasSample) return mOptions.maxTimeout;
+    const auto total = rto() * std::max<uint32_t>(mOptions.timeoutRtoCount, 1);
+    return std::min(std::chrono::ceil<std::chrono::milliseconds>(total), mOptions.maxTimeout);
+}
+
+RttEstimator RttCache::get(std::string_view host, uint16_t port) const {
+    const std::string key = makeKey(host, port);
+    std::lock_guard   lock{mMutex};
+    if (const auto it = mIndex.find(key); it != mIndex.end()) return it->second->estimator;
+    return RttEstimator{mOptions};
+}
+
+void RttCache::addSample(std::string_view host, uint16_t port, std::chrono::microseconds rtt) {
+    const std::string key = makeKey(host, port);
+    std::lock_guard   lock{mMutex};
+    at(key).addSample(rtt);
+}
+
+void RttCache::onTimeout(std::string_view host, uint16_t port) {
+    const std::string key = makeKey(host, port);
+    std::lock_guard   lock{mMutex};
+    at(key).onTimeout();
+}
+
+void RttCache::erase(std::string_view host, uint16_t port) {
+    const std::string key = makeKey(host, port);
+    std::lock_guard   lock{mMutex};
+    const auto        it = mIndex.find(key);
+    if (it == mIndex.end()) return;
+    const auto entry = it->second;
+    mIndex.erase(it);
+    mEntries.erase(entry);
+}
+
+void RttCache::clear() {
+    std::lock_guard lock{mMutex};
+    mIndex.clear();
+    mEntries.clear();
+}
+
+size_t RttCache::size() const {
+    std::lock_guard lock{mMutex};
+    return mIndex.size();
+}
+
+RttEstimator& RttCache::at(std::string_view key) {
+    if (const auto it = mIndex.find(key); it != mIndex.end()) {
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        return it->second->estimator;
+    }
+    if (mIndex.size() >= mCapacity) {
+        mIndex.erase(mEntries.back().key);
+        mEntries.pop_back();
+    }
+    mEntries.push_front(Entry{std::string{key}, RttEstimator{mOptions}});
+    mIndex.emplace(mEntries.front().key, mEntries.begin());
+    return mEntries.front().estimator;
+}
+
+} // namespace motdpe
\ No newline at end of file
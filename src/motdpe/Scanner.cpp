@@ -0,0 +1,487 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/Scanner.hpp"
+#include "detail/Json.hpp"
+#include "detail/Permutation.hpp"
+#include "detail/PingEngine.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <format>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <unordered_set>
+
+namespace motdpe {
+
+namespace detail {
+
+constexpr unsigned MAX_HOST_BITS = 32;
+constexpr uint64_t SEND_BATCH    = 4096;
+
+constexpr std::chrono::milliseconds PAUSE_POLL{5};
+
+// Adds `offset` to the low 64 bits of the address.
+Endpoint offsetAddress(const Endpoint& base, uint64_t offset) noexcept {
+    Endpoint     result = base;
+    const size_t last   = base.ipv6 ? 15 : 3;
+    for (size_t i = 0; i < 8 && offset != 0; ++i) {
+        const uint64_t sum       = result.address[last - i] + (offset & 0xFF);
+        result.address[last - i] = static_cast<uint8_t>(sum);
+        offset                   = (offset >> 8) + (sum >> 8);
+    }
+    return result;
+}
+
+// Server id of a raw pong payload, the seventh ';'-separated field.
+std::string_view pongServerId(std::string_view motd) noexcept {
+    for (int field = 0; field < 6; ++field) {
+        const auto end = motd.find(';');
+        if (end == std::string_view::npos) return {};
+        motd.remove_prefix(end + 1);
+    }
+    return motd.substr(0, motd.find(';'));
+}
+
+// One line of ScanOptions::sink; the payload is referenced by id when a store holds it.
+void appendHitJson(std::string& out, const ScanHit& hit) {
+    out += "{\"address\":";
+    appendJsonString(out, hit.endpoint.addressString());
+    out += ",\"port\":";
+    appendNumber(out, hit.endpoint.port);
+    out += ",\"rtt_us\":";
+    appendNumber(out, hit.rtt.count());
+    if (hit.payload) {
+        out += ",\"payload\":\"";
+        out += hit.payload.toString();
+        out += '"';
+    } else {
+        out += ",\"motd\":";
+        appendJsonString(out, hit.motd);
+    }
+    out += "}\n";
+}
+
+// Inverse of the standard normal CDF (P. J. Acklam's rational approximation, relative error below 1.2e-9).
+double normalQuantile(double p) noexcept {
+    constexpr double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                            1.383577518672690e+02,  -3.066479806614716e+01, 2.506628277459239e+00};
+    constexpr double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                            6.680131188771972e+01,  -1.328068155288572e+01};
+    constexpr double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                            -2.549732539343734e+00, 4.374664141464968e+00,  2.938163982698783e+00};
+    constexpr double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00};
+    constexpr double LOW = 0.02425;
+
+    p = std::clamp(p, 1e-12, 1.0 - 1e-12);
+    if (p < LOW || p > 1.0 - LOW) {
+        const double q = std::sqrt(-2.0 * std::log(p < LOW ? p : 1.0 - p));
+        const double x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+                       / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+        return p < LOW ? x : -x;
+    }
+    const double q = p - 0.5;
+    const double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+         / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+}
+
+// Wilson score interval for a proportion sampled without replacement from `population` items.
+std::pair<double, double> wilsonInterval(uint64_t hits, uint64_t sampled, double population, double z) noexcept {
+    const auto   n   = static_cast<double>(sampled);
+    const double p   = static_cast<double>(hits) / n;
+    const double fpc = population > 1.0 ? std::max(0.0, (population - n) / (population - 1.0)) : 0.0;
+    const double z2  = z * z;
+
+    const double denominator = 1.0 + z2 / n;
+    const double center      = (p + z2 / (2.0 * n)) / denominator;
+    const double half        = z / denominator * std::sqrt((p * (1.0 - p) / n + z2 / (4.0 * n * n)) * fpc);
+    return {std::max(0.0, center - half), std::min(1.0, center + half)};
+}
+
+class EnrichmentStage {
+public:
+    EnrichmentStage(const EnrichmentOptions& options, const Scanner::EnrichedCallback& onEnriched)
+    : mOptions(options),
+      mOnEnriched(onEnriched) {
+        const size_t workers = std::max<size_t>(options.concurrency, 1);
+        mWorkers.reserve(workers);
+        for (size_t i = 0; i < workers; ++i) mWorkers.emplace_back([this] { work(); });
+    }
+
+    ~EnrichmentStage() {
+        try {
+            finish();
+        } catch (...) {}
+    }
+
+    EnrichmentStage(const EnrichmentStage&)            = delete;
+    EnrichmentStage& operator=(const EnrichmentStage&) = delete;
+
+    // Sending pauses while the queue is full, but pongs of pings already in flight keep arriving; those are not
+    // queued, so the capacity bounds memory. Returns false for a dropped hit.
+    bool push(ScanHit hit) {
+        {
+            std::lock_guard lock{mMutex};
+            if (mQueue.size() >= mOptions.queueCapacity) return false;
+            mQueue.push_back(std::move(hit));
+        }
+        mReady.notify_one();
+        return true;
+    }
+
+    [[nodiscard]] bool saturated() const {
+        std::lock_guard lock{mMutex};
+        return mQueue.size() >= mOptions.queueCapacity;
+    }
+
+    // Waits for every queued hit to be enriched and stops the workers.
+    uint64_t finish() {
+        {
+            std::lock_guard lock{mMutex};
+            mClosed = true;
+        }
+        mReady.notify_all();
+        for (auto& worker : mWorkers) {
+            if (worker.joinable()) worker.join();
+        }
+        if (mError) std::rethrow_exception(std::exchange(mError, nullptr));
+        return mCompleted;
+    }
+
+private:
+    void work() {
+        for (;;) {
+            ScanHit hit;
+            {
+                std::unique_lock lock{mMutex};
+                mReady.wait(lock, [this] { return mClosed || !mQueue.empty(); });
+                if (mQueue.empty()) return;
+                hit = std::move(mQueue.front());
+                mQueue.pop_front();
+            }
+
+            const Enrichment enrichment = enrich(hit.endpoint, mOptions);
+
+            std::lock_guard lock{mCallbackMutex};
+            ++mCompleted;
+            if (mError || !mOnEnriched) continue;
+            try {
+                mOnEnriched(hit, enrichment);
+            } catch (...) {
+                mError = std::current_exception();
+            }
+        }
+    }
+
+    const EnrichmentOptions&         mOptions;
+    const Scanner::EnrichedCallback& mOnEnriched;
+    mutable std::mutex               mMutex;
+    std::condition_variable          mReady;
+    std::deque<ScanHit>              mQueue;
+    bool                             mClosed = false;
+    std::mutex                       mCallbackMutex;
+    uint64_t                         mCompleted = 0;
+    std::exception_ptr               mError;
+    std::vector<std::thread>         mWorkers;
+};
+
+} // namespace detail
+
+void Scanner::addRange(std::string_view cidr) {
+    const auto slash   = cidr.find('/');
+    const auto address = cidr.substr(0, slash);
+    const auto base    = Endpoint::parse(address, 0);
+    if (!base) throw detail::MotdException{std::format("Invalid scan range: {}", cidr)};
+
+    const unsigned width  = base->ipv6 ? 128 : 32;
+    unsigned       prefix = width;
+    if (slash != std::string_view::npos) {
+        const auto text = cidr.substr(slash + 1);
+        if (std::from_chars(text.data(), text.data() + text.size(), prefix).ec != std::errc{} || prefix > width) {
+            throw detail::MotdException{std::format("Invalid prefix length in scan range: {}", cidr)};
+        }
+    }
+    if (width - prefix > detail::MAX_HOST_BITS) {
+        throw detail::MotdException{std::format("Scan range too large: {}", cidr)};
+    }
+
+    // Clear the host bits so that "10.0.0.7/24" scans 10.0.0.0/24.
+    Endpoint network = *base;
+    for (unsigned bit = prefix; bit < width; ++bit) network.address[bit / 8] &= ~(0x80 >> (bit % 8));
+
+    const uint64_t count = uint64_t{1} << (width - prefix);
+    mRanges.push_back(Range{network, count});
+    mRangeEnds.push_back((mRangeEnds.empty() ? 0 : mRangeEnds.back()) + count);
+}
+
+uint64_t Scanner::size() const noexcept {
+    return (mRangeEnds.empty() ? 0 : mRangeEnds.back()) * mOptions.ports.size();
+}
+
+Endpoint Scanner::addressAt(uint64_t address) const {
+    const auto     range = std::upper_bound(mRangeEnds.begin(), mRangeEnds.end(), address) - mRangeEnds.begin();
+    const uint64_t start = range == 0 ? 0 : mRangeEnds[range - 1];
+    return detail::offsetAddress(mRanges[range].base, address - start);
+}
+
+Endpoint Scanner::targetAt(uint64_t index) const {
+    const uint64_t ports  = mOptions.ports.size();
+    Endpoint       target = addressAt(index / ports);
+    target.port           = mOptions.ports[index % ports];
+    return target;
+}
+
+std::optional<uint64_t> Scanner::addressIndexOf(const Endpoint& endpoint) const noexcept {
+    // Host parts are at most 32 bits wide, so they live in the last four address bytes.
+    const size_t last    = endpoint.ipv6 ? 15 : 3;
+    const auto   lowWord = [last](const Endpoint& e) {
+        return uint64_t{e.address[last - 3]} << 24 | uint64_t{e.address[last - 2]} << 16
+             | uint64_t{e.address[last - 1]} << 8 | uint64_t{e.address[last]};
+    };
+
+    const uint64_t low = lowWord(endpoint);
+    for (size_t i = 0; i < mRanges.size(); ++i) {
+        const Range& range = mRanges[i];
+        if (range.base.ipv6 != endpoint.ipv6) continue;
+        if (!std::equal(endpoint.address.begin(), endpoint.address.begin() + (last - 3), range.base.address.begin())) {
+            continue;
+        }
+        const uint64_t base = lowWord(range.base);
+        if (low >= base && low - base < range.count) return (i == 0 ? 0 : mRangeEnds[i - 1]) + (low - base);
+    }
+    return std::nullopt;
+}
+
+Scanner::TargetSource Scanner::permutedTargets() const {
+    const uint64_t seed = mOptions.seed != 0 ? mOptions.seed : std::random_device{}() | 1ull << 32;
+    return [this, permutation = detail::Permutation{size(), seed}](uint64_t index) -> std::optional<Endpoint> {
+        return targetAt(permutation(index));
+    };
+}
+
+ScanStats Scanner::run(const HitCallback& onHit) { return runImpl(size(), permutedTargets(), onHit, nullptr, {}); }
+
+ScanStats Scanner::run(
+    const EnrichmentOptions& enrichment,
+    const EnrichedCallback&  onEnriched,
+    const HitCallback&       onHit
+) {
+    const auto              start = std::chrono::steady_clock::now();
+    detail::EnrichmentStage stage{enrichment, onEnriched};
+    ScanStats               stats = runImpl(size(), permutedTargets(), onHit, &stage, {});
+
+    stats.enriched = stage.finish();
+    stats.elapsed  = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    return stats;
+}
+
+PopulationEstimate Scanner::estimate(const EstimateOptions& options, const HitCallback& onHit) {
+    using Clock = std::chrono::steady_clock;
+
+    PopulationEstimate result;
+    const double       z          = detail::normalQuantile(0.5 + options.confidence / 2.0);
+    const auto         population = static_cast<double>(size());
+
+    const auto update = [&](uint64_t hits, uint64_t sampled) {
+        result.sampled = sampled;
+        result.hits    = hits;
+        if (sampled == 0) return;
+
+        const auto [lower, upper] = detail::wilsonInterval(hits, sampled, population, z);
+        result.estimate           = population * static_cast<double>(hits) / static_cast<double>(sampled);
+        result.lower              = population * lower;
+        result.upper              = population * upper;
+        result.converged          = hits >= options.minHits
+                        && (result.upper - result.lower) / 2.0 <= options.relativeError * result.estimate;
+    };
+
+    // Pongs come back within one RTT while misses take a full timeout to resolve, so counting outcomes as they
+    // arrive overestimates the hit ratio. Only targets drawn at least one timeout ago enter the running estimate.
+    std::deque<std::pair<Clock::time_point, uint64_t>>                                 drawn;
+    std::priority_queue<Clock::time_point, std::vector<Clock::time_point>, std::greater<>> hitSendTimes;
+    uint64_t                                                                           settledDrawn = 0;
+    uint64_t                                                                           settledHits  = 0;
+
+    const auto recordHit = [&](const ScanHit& hit) {
+        hitSendTimes.push(Clock::now() - hit.rtt);
+        if (onHit) onHit(hit);
+    };
+
+    const auto stopSending = [&](const ScanStats& stats) {
+        const auto now = Clock::now();
+        drawn.emplace_back(now, stats.sent + stats.filtered);
+        while (!drawn.empty() && drawn.front().first + mOptions.timeout <= now) {
+            const auto [cutoff, count] = drawn.front();
+            drawn.pop_front();
+            settledDrawn = count;
+            for (; !hitSendTimes.empty() && hitSendTimes.top() < cutoff; hitSendTimes.pop()) ++settledHits;
+        }
+        update(settledHits, settledDrawn);
+        return result.converged || (options.maxSamples != 0 && stats.sent + stats.filtered >= options.maxSamples);
+    };
+
+    result.stats = runImpl(size(), permutedTargets(), recordHit, nullptr, stopSending);
+    // Everything sent has resolved by now; filtered targets are sampled addresses that host no counted server. As in
+    // the running estimate, duplicates were sampled but are not counted as hits.
+    const ScanStats& stats = result.stats;
+    update(stats.hits - stats.duplicates, stats.hits + stats.timeouts + stats.filtered);
+    return result;
+}
+
+ScanStats Scanner::rescan(
+    std::span<const Endpoint> previousHits,
+    const RescanOptions&      options,
+    const HitCallback&        onHit
+) {
+    struct Anchor {
+        uint64_t address;
+        uint64_t rangeBegin;
+        uint64_t rangeEnd;
+        uint16_t port;
+    };
+
+    // Known hits first, then their neighbours ordered by distance, so the likeliest servers are refreshed earliest.
+    std::vector<Endpoint>                      priority;
+    std::unordered_set<Endpoint, EndpointHash> queued;
+    std::vector<Anchor>                        anchors;
+    for (const Endpoint& hit : previousHits) {
+        const auto address = addressIndexOf(hit);
+        if (!address) continue;
+        if (queued.insert(hit).second) priority.push_back(hit);
+
+        const auto range = std::upper_bound(mRangeEnds.begin(), mRangeEnds.end(), *address) - mRangeEnds.begin();
+        anchors.push_back(Anchor{*address, range == 0 ? 0 : mRangeEnds[range - 1], mRangeEnds[range], hit.port});
+    }
+    for (uint64_t distance = 1; distance <= options.neighborRadius; ++distance) {
+        for (const Anchor& anchor : anchors) {
+            for (const bool below : {true, false}) {
+                const uint64_t room = below ? anchor.address - anchor.rangeBegin : anchor.rangeEnd - anchor.address - 1;
+                if (room < distance) continue;
+
+                Endpoint target = addressAt(below ? anchor.address - distance : anchor.address + distance);
+                target.port     = anchor.port;
+                if (queued.insert(target).second) priority.push_back(std::move(target));
+            }
+        }
+    }
+
+    const uint64_t space      = size();
+    const auto     background = std::min<uint64_t>(
+        space,
+        static_cast<uint64_t>(std::ceil(std::clamp(options.backgroundFraction, 0.0, 1.0) * static_cast<double>(space)))
+    );
+    const uint64_t backgroundStart = space == 0 ? 0 : options.backgroundStart % space;
+
+    const TargetSource permuted  = permutedTargets();
+    const TargetSource targetFor = [&](uint64_t index) -> std::optional<Endpoint> {
+        if (index < priority.size()) return priority[index];
+        auto target = permuted((backgroundStart + index - priority.size()) % space);
+        if (queued.contains(*target)) return std::nullopt;
+        return target;
+    };
+    return runImpl(priority.size() + background, targetFor, onHit, nullptr, {});
+}
+
+ScanStats Scanner::runImpl(
+    uint64_t                 targets,
+    const TargetSource&      targetFor,
+    const HitCallback&       onHit,
+    detail::EnrichmentStage* stage,
+    const StopPredicate&     stopSending
+) {
+    using Clock = std::chrono::steady_clock;
+
+    ScanStats stats;
+    stats.targets = targets;
+
+    const RangeFilter* filter = mOptions.filter.get();
+    SinkWriter*        sink   = mOptions.sink.get();
+    detail::PingEngine engine{mOptions.transport, mOptions.rate};
+    const auto         start = Clock::now();
+    uint64_t           next  = 0;
+    uint64_t           limit = stats.targets;
+    std::string        line;
+
+    while (next < limit || engine.inFlight() > 0) {
+        if (stopSending && next < limit && stopSending(stats)) limit = next;
+
+        auto now = Clock::now();
+
+        // A saturated sink keeps cutting the rate; the controller holds after each decrease, so this does not
+        // collapse it within one hold period.
+        const bool sinkBehind = sink && sink->saturated();
+        if (sinkBehind) engine.congest(now);
+
+        // Bounded so that pongs are drained between bursts even when the rate is high.
+        const bool paused = (stage && stage->saturated()) || sinkBehind;
+        for (const uint64_t end = std::min(limit, next + detail::SEND_BATCH); !paused && next < end; ++next) {
+            using enum detail::PingEngine::SendResult;
+            const auto target = targetFor(next);
+            if (!target) continue;
+            if (filter && !filter->permits(*target)) {
+                ++stats.filtered;
+                continue;
+            }
+            const auto result = engine.send(*target, 0, now + mOptions.timeout);
+            if (result == RateLimited || result == WouldBlock) break;
+            if (result == Sent) ++stats.sent;
+        }
+
+        while (auto pong = engine.receive()) {
+            ++stats.hits;
+            if (mOptions.seen) {
+                const auto serverId =
+                    mOptions.dedupeBy == DedupeKey::ServerId ? detail::pongServerId(pong->motd) : std::string_view{};
+                if (!mOptions.seen->insert(
+                        serverId.empty() ? BloomFilter::hash(pong->endpoint) : BloomFilter::hash(serverId)
+                    )) {
+                    ++stats.duplicates;
+                    continue;
+                }
+            }
+            // With a store the payload is kept there once and the hit carries only its id.
+            ScanHit hit{pong->endpoint, {}, pong->rtt, {}};
+            if (mOptions.payloads) {
+                hit.payload = mOptions.payloads->intern(pong->motd);
+            } else {
+                hit.motd = std::string{pong->motd};
+            }
+            if (onHit) onHit(hit);
+            if (sink) {
+                line.clear();
+                detail::appendHitJson(line, hit);
+                sink->write(line);
+            }
+            if (stage && !stage->push(std::move(hit))) ++stats.unenriched;
+        }
+
+        now = Clock::now();
+        while (engine.expire(now)) ++stats.timeouts;
+
+        auto until = engine.nextDeadline();
+        if (paused) {
+            until = std::min(until.value_or(Clock::time_point::max()), Clock::now() + detail::PAUSE_POLL);
+        } else if (next < limit) {
+            until = std::min(until.value_or(Clock::time_point::max()), engine.nextSendTime());
+        }
+        if (until) engine.wait(*until);
+    }
+
+    stats.rate    = engine.rate();
+    stats.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    stats.sources = engine.sourceStats();
+    return stats;
+}
+
+} // namespace motdpe
\ No newline at end of file
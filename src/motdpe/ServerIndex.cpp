@@ -0,0 +1,295 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/ServerIndex.hpp"
+#include "detail/Bitmap.hpp"
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace motdpe {
+
+namespace detail {
+
+// Filters matching fewer rows than 1/16 of the index are served by sorting the matches instead of walking the ordered
+// index, which would mostly visit rows the filter rejects.
+constexpr size_t SERVER_INDEX_SELECTIVITY = 16;
+
+// Dictionary-encoded string attribute with one bitmap per distinct value. Codes are never reused: editions, versions
+// and game modes have few distinct values, and an emptied bitmap costs nothing to intersect.
+class AttributeIndex {
+public:
+    uint32_t insert(std::string_view value, size_t row) {
+        auto it = mCodes.find(value);
+        if (it == mCodes.end()) {
+            it = mCodes.emplace(std::string{value}, static_cast<uint32_t>(mBitmaps.size())).first;
+            mBitmaps.emplace_back();
+        }
+        mBitmaps[it->second].set(row);
+        return it->second;
+    }
+
+    void erase(uint32_t code, size_t row) noexcept { mBitmaps[code].reset(row); }
+
+    [[nodiscard]] std::optional<uint32_t> code(std::string_view value) const {
+        const auto it = mCodes.find(value);
+        return it == mCodes.end() ? std::nullopt : std::optional{it->second};
+    }
+
+    [[nodiscard]] const Bitmap* find(std::string_view value) const {
+        const auto found = code(value);
+        return found ? &mBitmaps[*found] : nullptr;
+    }
+
+private:
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view key) const noexcept { return std::hash<std::string_view>{}(key); }
+    };
+
+    std::unordered_map<std::string, uint32_t, KeyHash, std::equal_to<>> mCodes;
+    std::vector<Bitmap>                                                  mBitmaps;
+};
+
+class ServerIndexImpl {
+public:
+    void update(uint64_t id, const Pong& pong) {
+        std::unique_lock lock{mMutex};
+        const auto [it, inserted] = mRowOf.try_emplace(id, 0);
+        if (inserted) {
+            it->second = allocate(id);
+        } else {
+            const Row& row = mRows[it->second];
+            // A target coming back with the same pong touches no index.
+            if (row.online == pong.online && row.max == pong.max && row.protocol == pong.protocol
+                && sameText(row.edition, mEditions, pong.edition) && sameText(row.version, mVersions, pong.version)
+                && sameText(row.gameMode, mGameModes, pong.gameMode)) {
+                mUp.set(it->second);
+                return;
+            }
+            unindex(it->second);
+        }
+
+        const uint32_t index = it->second;
+        Row&           row   = mRows[index];
+        row.online           = pong.online;
+        row.max              = pong.max;
+        row.protocol         = pong.protocol;
+        row.edition          = mEditions.insert(pong.edition, index);
+        row.version          = mVersions.insert(pong.version, index);
+        row.gameMode         = mGameModes.insert(pong.gameMode, index);
+        mProtocols[row.protocol].set(index);
+        mFreeSlots.assign(index, row.online < row.max);
+        mByPlayers.insert(Key{row.online, index});
+        mByMax.insert(Key{row.max, index});
+        mUp.set(index);
+    }
+
+    void setUp(uint64_t id, bool up) {
+        std::unique_lock lock{mMutex};
+        const auto       it = mRowOf.find(id);
+        if (it != mRowOf.end()) mUp.assign(it->second, up);
+    }
+
+    bool erase(uint64_t id) {
+        std::unique_lock lock{mMutex};
+        const auto       it = mRowOf.find(id);
+        if (it == mRowOf.end()) return false;
+        const uint32_t index = it->second;
+        unindex(index);
+        mLive.reset(index);
+        mUp.reset(index);
+        mFreeRows.push_back(index);
+        mRowOf.erase(it);
+        return true;
+    }
+
+    [[nodiscard]] std::vector<ServerMatch> query(const ServerQuery& query) const {
+        std::shared_lock         lock{mMutex};
+        std::vector<ServerMatch> matches;
+        Bitmap                   filter;
+        if (query.limit == 0 || !select(query, filter)) return matches;
+
+        const auto& ordered = query.order == ServerOrder::Players ? mByPlayers : mByMax;
+        if (filter.count() * SERVER_INDEX_SELECTIVITY < ordered.size()) {
+            std::vector<Key> keys;
+            filter.forEach([&](size_t index) {
+                const Row& row = mRows[index];
+                if (!inRange(query, row)) return;
+                const int32_t value = query.order == ServerOrder::Players ? row.online : row.max;
+                keys.push_back(Key{value, static_cast<uint32_t>(index)});
+            });
+            if (query.offset >= keys.size()) return matches;
+            const size_t end = query.offset + std::min(query.limit, keys.size() - query.offset);
+            if (query.ascending) {
+                std::partial_sort(keys.begin(), keys.begin() + static_cast<ptrdiff_t>(end), keys.end());
+            } else {
+                std::partial_sort(keys.begin(), keys.begin() + static_cast<ptrdiff_t>(end), keys.end(), std::greater{});
+            }
+            for (size_t i = query.offset; i < end; ++i) matches.push_back(match(keys[i].row));
+            return matches;
+        }
+
+        auto first = ordered.begin();
+        auto last  = ordered.end();
+        // Ordered by players, the player range is a contiguous slice of the index.
+        if (query.order == ServerOrder::Players) {
+            first = ordered.lower_bound(Key{query.minPlayers, 0});
+            last  = ordered.upper_bound(Key{query.maxPlayers, UINT32_MAX});
+        }
+        const auto walk = [&](auto it, auto end) {
+            size_t skipped = 0;
+            for (; it != end && matches.size() < query.limit; ++it) {
+                if (!filter.test(it->row) || !inRange(query, mRows[it->row])) continue;
+                if (skipped < query.offset) {
+                    ++skipped;
+                    continue;
+                }
+                matches.push_back(match(it->row));
+            }
+        };
+        if (query.ascending) {
+            walk(first, last);
+        } else {
+            walk(std::make_reverse_iterator(last), std::make_reverse_iterator(first));
+        }
+        return matches;
+    }
+
+    [[nodiscard]] size_t count(const ServerQuery& query) const {
+        std::shared_lock lock{mMutex};
+        Bitmap           filter;
+        if (!select(query, filter)) return 0;
+        if (query.minPlayers == INT32_MIN && query.maxPlayers == INT32_MAX) return filter.count();
+        size_t total = 0;
+        filter.forEach([&](size_t index) { total += inRange(query, mRows[index]) ? 1 : 0; });
+        return total;
+    }
+
+    [[nodiscard]] size_t size() const {
+        std::shared_lock lock{mMutex};
+        return mRowOf.size();
+    }
+
+private:
+    struct Row {
+        uint64_t id       = 0;
+        int32_t  online   = 0;
+        int32_t  max      = 0;
+        int32_t  protocol = 0;
+        uint32_t edition  = 0;
+        uint32_t version  = 0;
+        uint32_t gameMode = 0;
+    };
+
+    struct Key {
+        int32_t  value;
+        uint32_t row;
+
+        auto operator<=>(const Key&) const = default;
+    };
+
+    [[nodiscard]] static bool inRange(const ServerQuery& query, const Row& row) noexcept {
+        return row.online >= query.minPlayers && row.online <= query.maxPlayers;
+    }
+
+    [[nodiscard]] static bool sameText(uint32_t code, const AttributeIndex& index, std::string_view value) {
+        return index.code(value) == code;
+    }
+
+    uint32_t allocate(uint64_t id) {
+        uint32_t index;
+        if (mFreeRows.empty()) {
+            index = static_cast<uint32_t>(mRows.size());
+            mRows.emplace_back();
+        } else {
+            index = mFreeRows.back();
+            mFreeRows.pop_back();
+        }
+        mRows[index]    = Row{};
+        mRows[index].id = id;
+        mLive.set(index);
+        return index;
+    }
+
+    void unindex(uint32_t index) {
+        const Row& row = mRows[index];
+        mEditions.erase(row.edition, index);
+        mVersions.erase(row.version, index);
+        mGameModes.erase(row.gameMode, index);
+        mProtocols[row.protocol].reset(index);
+        mFreeSlots.reset(index);
+        mByPlayers.erase(Key{row.online, index});
+        mByMax.erase(Key{row.max, index});
+    }
+
+    // Intersects the bitmaps of every filter; false if a filter value was never seen, so nothing can match.
+    bool select(const ServerQuery& query, Bitmap& filter) const {
+        filter = query.includeDown ? mLive : mUp;
+        if (query.freeSlots) filter.intersect(mFreeSlots);
+        const auto narrow = [&](const AttributeIndex& index, const std::optional<std::string>& value) {
+            if (!value) return true;
+            const Bitmap* bitmap = index.find(*value);
+            if (bitmap) filter.intersect(*bitmap);
+            return bitmap != nullptr;
+        };
+        if (!narrow(mEditions, query.edition) || !narrow(mVersions, query.version)
+            || !narrow(mGameModes, query.gameMode)) {
+            return false;
+        }
+        if (query.protocol) {
+            const auto it = mProtocols.find(*query.protocol);
+            if (it == mProtocols.end()) return false;
+            filter.intersect(it->second);
+        }
+        return true;
+    }
+
+    [[nodiscard]] ServerMatch match(uint32_t index) const {
+        const Row& row = mRows[index];
+        return ServerMatch{row.id, row.online, row.max};
+    }
+
+    mutable std::shared_mutex              mMutex;
+    std::vector<Row>                       mRows;
+    std::vector<uint32_t>                  mFreeRows;
+    std::unordered_map<uint64_t, uint32_t> mRowOf;
+    Bitmap                                 mLive;
+    Bitmap                                 mUp;
+    Bitmap                                 mFreeSlots;
+    AttributeIndex                         mEditions;
+    AttributeIndex                         mVersions;
+    AttributeIndex                         mGameModes;
+    std::unordered_map<int32_t, Bitmap>    mProtocols;
+    std::set<Key>                          mByPlayers;
+    std::set<Key>                          mByMax;
+};
+
+} // namespace detail
+
+ServerIndex::ServerIndex() : mImpl(std::make_unique<detail::ServerIndexImpl>()) {}
+
+ServerIndex::~ServerIndex() = default;
+
+void ServerIndex::update(uint64_t id, const Pong& pong) { mImpl->update(id, pong); }
+
+void ServerIndex::setUp(uint64_t id, bool up) { mImpl->setUp(id, up); }
+
+bool ServerIndex::erase(uint64_t id) { return mImpl->erase(id); }
+
+std::vector<ServerMatch> ServerIndex::query(const ServerQuery& query) const { return mImpl->query(query); }
+
+size_t ServerIndex::count(const ServerQuery& query) const { return mImpl->count(query); }
+
+size_t ServerIndex::size() const { return mImpl->size(); }
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,378 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/SinkWriter.hpp"
+#include "detail/Lz4.hpp"
+#include "detail/Socket.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <format>
+#include <mutex>
+#include <new>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace motdpe {
+
+namespace detail {
+
+// Direct writes must start at, and cover, multiples of the device block size from memory aligned to it; 4 KiB
+// satisfies every common device.
+constexpr size_t SINK_ALIGNMENT   = 4096;
+constexpr size_t SINK_MIN_BUFFERS = 2;
+
+template <typename T>
+struct AlignedAllocator {
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{SINK_ALIGNMENT}));
+    }
+    void deallocate(T* pointer, size_t) noexcept { ::operator delete(pointer, std::align_val_t{SINK_ALIGNMENT}); }
+
+    bool operator==(const AlignedAllocator&) const noexcept = default;
+};
+
+// Write-only file, optionally bypassing the page cache. Direct files only take aligned writes; the last one is padded
+// and the file cut back to its real length by truncate().
+class SinkFile {
+public:
+    SinkFile(const std::filesystem::path& path, bool direct) {
+#ifdef _WIN32
+        const DWORD flags = FILE_ATTRIBUTE_NORMAL;
+        if (direct) {
+            mHandle = CreateFileW(
+                path.c_str(),
+                GENERIC_WRITE,
+                FILE_SHARE_READ,
+                nullptr,
+                CREATE_ALWAYS,
+                flags | FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH,
+                nullptr
+            );
+            mDirect = mHandle != INVALID_HANDLE_VALUE;
+        }
+        if (mHandle == INVALID_HANDLE_VALUE) {
+            mHandle = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, flags, nullptr);
+        }
+        if (mHandle == INVALID_HANDLE_VALUE) {
+            throw MotdException{std::format("Failed to open {}: {}", path.string(), GetLastError())};
+        }
+#else
+        constexpr int FLAGS = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+#ifdef O_DIRECT
+        // tmpfs and some network filesystems reject O_DIRECT with EINVAL.
+        if (direct) {
+            mFd     = ::open(path.c_str(), FLAGS | O_DIRECT, 0644);
+            mDirect = mFd >= 0;
+        }
+#endif
+        if (mFd < 0) mFd = ::open(path.c_str(), FLAGS, 0644);
+        if (mFd < 0) throw MotdException{std::format("Failed to open {}: {}", path.string(), std::strerror(errno))};
+#ifdef F_NOCACHE
+        if (direct) mDirect = fcntl(mFd, F_NOCACHE, 1) == 0;
+#endif
+#endif
+    }
+
+    ~SinkFile() { close(); }
+
+    SinkFile(const SinkFile&)            = delete;
+    SinkFile& operator=(const SinkFile&) = delete;
+
+    [[nodiscard]] bool direct() const noexcept { return mDirect; }
+
+    void write(const uint8_t* data, size_t size) {
+        while (size > 0) {
+#ifdef _WIN32
+            // Chunks stay multiples of the alignment.
+            const auto chunk   = static_cast<DWORD>(std::min<size_t>(size, size_t{1} << 30));
+            DWORD      written = 0;
+            if (!WriteFile(mHandle, data, chunk, &written, nullptr)) {
+                throw MotdException{std::format("Sink write failed: {}", GetLastError())};
+            }
+#else
+            const ssize_t written = ::write(mFd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw MotdException{std::format("Sink write failed: {}", std::strerror(errno))};
+            }
+#endif
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+
+    void truncate(uint64_t size) {
+#ifdef _WIN32
+        LARGE_INTEGER position;
+        position.QuadPart = static_cast<LONGLONG>(size);
+        if (!SetFilePointerEx(mHandle, position, nullptr, FILE_BEGIN) || !SetEndOfFile(mHandle)) {
+            throw MotdException{std::format("Failed to truncate sink: {}", GetLastError())};
+        }
+#else
+        if (ftruncate(mFd, static_cast<off_t>(size)) != 0) {
+            throw MotdException{std::format("Failed to truncate sink: {}", std::strerror(errno))};
+        }
+#endif
+    }
+
+    void close() noexcept {
+#ifdef _WIN32
+        if (mHandle != INVALID_HANDLE_VALUE) CloseHandle(mHandle);
+        mHandle = INVALID_HANDLE_VALUE;
+#else
+        if (mFd >= 0) ::close(mFd);
+        mFd = -1;
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    HANDLE mHandle = INVALID_HANDLE_VALUE;
+#else
+    int mFd = -1;
+#endif
+    bool mDirect = false;
+};
+
+class SinkThread {
+public:
+    SinkThread(const std::filesystem::path& path, const SinkOptions& options)
+    : mOptions(options),
+      mFile(path, options.direct),
+      mBuffers(std::max(options.buffers, SINK_MIN_BUFFERS)) {
+        mCurrent.reserve(mOptions.bufferSize);
+        mFree.resize(mBuffers - 1);
+        for (auto& buffer : mFree) buffer.reserve(mOptions.bufferSize);
+        mStats.direct = mFile.direct();
+        if (mOptions.compression == SinkCompression::Lz4) {
+            mOut.resize(Lz4FrameEncoder::HEADER_SIZE);
+            mEncoder.begin(mOut.data());
+        }
+        mWriter = std::thread{[this] { run(); }};
+    }
+
+    ~SinkThread() {
+        try {
+            close();
+        } catch (...) {}
+    }
+
+    SinkThread(const SinkThread&)            = delete;
+    SinkThread& operator=(const SinkThread&) = delete;
+
+    void write(std::string_view record) {
+        std::unique_lock lock{mMutex};
+        if (mError) std::rethrow_exception(mError);
+        if (mClosed) throw MotdException{"Sink is closed"};
+
+        if (!mCurrent.empty() && mCurrent.size() + record.size() > mOptions.bufferSize) handOver(lock);
+        mCurrent.append(record);
+        mStats.bytesIn += record.size();
+        if (mCurrent.size() >= mOptions.bufferSize) handOver(lock);
+        if (mError) std::rethrow_exception(mError);
+    }
+
+    void flush() {
+        std::unique_lock lock{mMutex};
+        if (mClosed) throw MotdException{"Sink is closed"};
+        if (!mCurrent.empty()) handOver(lock);
+        const uint64_t handed = mHanded;
+        mReturned.wait(lock, [&] { return mWritten >= handed || mError; });
+        if (mError) std::rethrow_exception(mError);
+    }
+
+    void close() {
+        {
+            std::unique_lock lock{mMutex};
+            if (mClosed) return;
+            mClosed = true;
+            if (!mCurrent.empty()) handOver(lock, true);
+            mClosing = true;
+        }
+        mFilled.notify_all();
+        mWriter.join();
+
+        // The writer thread is gone, so the tail is ours. Late write() calls still read mError, under the lock.
+        std::lock_guard lock{mMutex};
+        if (!mError) {
+            try {
+                if (mOptions.compression == SinkCompression::Lz4) {
+                    mOut.resize(mOut.size() + Lz4FrameEncoder::END_SIZE);
+                    mEncoder.end(mOut.data() + mOut.size() - Lz4FrameEncoder::END_SIZE);
+                }
+                mStats.bytesOut += drain(true);
+                if (mFile.direct()) mFile.truncate(mStats.bytesOut);
+            } catch (...) {
+                mError = std::current_exception();
+            }
+        }
+        mFile.close();
+        if (mError) std::rethrow_exception(mError);
+    }
+
+    [[nodiscard]] bool saturated() const noexcept {
+        return mQueued.load(std::memory_order_relaxed) * 2 >= mBuffers;
+    }
+
+    [[nodiscard]] SinkStats stats() const {
+        std::lock_guard lock{mMutex};
+        return mStats;
+    }
+
+private:
+    // Queues the current buffer and takes a free one, waiting for the writer if there is none. Returns without
+    // queueing once the writer has failed. Only close() itself may hand over once the sink is closed.
+    void handOver(std::unique_lock<std::mutex>& lock, bool closing = false) {
+        if (mFree.empty()) {
+            const auto start = std::chrono::steady_clock::now();
+            mReturned.wait(lock, [this] { return !mFree.empty() || mError; });
+            ++mStats.stalls;
+            mStats.stalled +=
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+            if (mError) return;
+            // close() ran while this caller waited; the writer thread may have exited, and a buffer queued now would
+            // never be written.
+            if (mClosed && !closing) throw MotdException{"Sink is closed"};
+        }
+        mFull.push_back(std::move(mCurrent));
+        mCurrent = std::move(mFree.back());
+        mFree.pop_back();
+        ++mHanded;
+        ++mStats.buffers;
+        mQueued.fetch_add(1, std::memory_order_relaxed);
+        mFilled.notify_one();
+    }
+
+    void run() {
+        for (;;) {
+            std::string buffer;
+            bool        failed;
+            {
+                std::unique_lock lock{mMutex};
+                mFilled.wait(lock, [this] { return mClosing || !mFull.empty(); });
+                if (mFull.empty()) return;
+                buffer = std::move(mFull.front());
+                mFull.pop_front();
+                failed = mError != nullptr;
+            }
+
+            uint64_t           written = 0;
+            std::exception_ptr error;
+            if (!failed) {
+                try {
+                    written = store(buffer);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+
+            {
+                std::lock_guard lock{mMutex};
+                buffer.clear();
+                mFree.push_back(std::move(buffer));
+                ++mWritten;
+                mStats.bytesOut += written;
+                if (error) mError = error;
+                mQueued.fetch_sub(1, std::memory_order_relaxed);
+            }
+            mReturned.notify_all();
+        }
+    }
+
+    // Compresses and writes one buffer; returns the bytes that reached the file.
+    uint64_t store(const std::string& buffer) {
+        const std::span bytes{reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size()};
+        if (mOptions.compression == SinkCompression::None && !mFile.direct()) {
+            mFile.write(bytes.data(), bytes.size());
+            return bytes.size();
+        }
+        if (mOptions.compression == SinkCompression::Lz4) {
+            const size_t at = mOut.size();
+            mOut.resize(at + Lz4FrameEncoder::bound(bytes.size()));
+            mOut.resize(at + mEncoder.encode(bytes, mOut.data() + at));
+        } else {
+            mOut.insert(mOut.end(), bytes.begin(), bytes.end());
+        }
+        return drain(false);
+    }
+
+    // Writes the pending output; direct files keep a partial last block back unless `last`, which pads it instead.
+    uint64_t drain(bool last) {
+        size_t length = mOut.size();
+        if (mFile.direct()) {
+            if (last) {
+                mOut.resize((length + SINK_ALIGNMENT - 1) / SINK_ALIGNMENT * SINK_ALIGNMENT);
+            } else {
+                length -= length % SINK_ALIGNMENT;
+            }
+        }
+        mFile.write(mOut.data(), last ? mOut.size() : length);
+        mOut.erase(mOut.begin(), mOut.begin() + static_cast<ptrdiff_t>(last ? mOut.size() : length));
+        return length;
+    }
+
+    const SinkOptions mOptions;
+    SinkFile          mFile;
+    const size_t      mBuffers;
+
+    // Owned by the writer thread until it exits.
+    Lz4FrameEncoder                                mEncoder;
+    std::vector<uint8_t, AlignedAllocator<uint8_t>> mOut;
+
+    mutable std::mutex       mMutex;
+    std::condition_variable  mFilled;
+    std::condition_variable  mReturned;
+    std::string              mCurrent;
+    std::vector<std::string> mFree;
+    std::deque<std::string>  mFull;
+    std::atomic<size_t>      mQueued{0};
+    uint64_t                 mHanded  = 0;
+    uint64_t                 mWritten = 0;
+    bool                     mClosing = false;
+    bool                     mClosed  = false;
+    std::exception_ptr       mError;
+    SinkStats                mStats;
+    std::thread              mWriter;
+};
+
+} // namespace detail
+
+SinkWriter::SinkWriter(const std::filesystem::path& path, const SinkOptions& options)
+: mThread(std::make_unique<detail::SinkThread>(path, options)) {}
+
+SinkWriter::~SinkWriter() = default;
+
+void SinkWriter::write(std::string_view record) { mThread->write(record); }
+
+void SinkWriter::flush() { mThread->flush(); }
+
+void SinkWriter::close() { mThread->close(); }
+
+bool SinkWriter::saturated() const noexcept { return mThread->saturated(); }
+
+SinkStats SinkWriter::stats() const { return mThread->stats(); }
+
+} // namespace motdpe
\ No newline at end of file
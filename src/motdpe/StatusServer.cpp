@@ -0,0 +1,476 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/StatusServer.hpp"
+#include "detail/Json.hpp"
+#include "detail/MpmcQueue.hpp"
+#include "detail/Socket.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <map>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <netinet/tcp.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#endif
+
+namespace motdpe {
+
+namespace detail {
+
+// Poll timeout without open connections; invalidations and shutdown wake the thread anyway.
+constexpr std::chrono::hours STATUS_IDLE_WAIT{1};
+
+// Requests are header-only; anything larger is refused.
+constexpr size_t STATUS_MAX_REQUEST = 8192;
+
+// Pipelined requests are left unparsed while this much output waits for a client that is not reading.
+constexpr size_t STATUS_MAX_OUTPUT = STATUS_MAX_REQUEST * 8;
+
+// Invalidations beyond this many pending ones fall back to re-rendering everything.
+constexpr size_t STATUS_INVALIDATION_QUEUE = 4096;
+
+constexpr std::string_view CONNECTION_KEEP_ALIVE = "Connection: keep-alive\r\n\r\n";
+constexpr std::string_view CONNECTION_CLOSE      = "Connection: close\r\n\r\n";
+
+// Status line and headers without the Connection header and the blank line, which depend on the request.
+struct CachedResponse {
+    std::string head;
+    std::string body;
+};
+
+std::string renderStatus(const StatusRecord& record) {
+    std::string out;
+    out.reserve(512);
+    out += "{\"id\":";
+    appendNumber(out, record.id);
+    out += ",\"up\":";
+    out += record.ok() ? "true" : "false";
+    out += ",\"failures\":";
+    appendNumber(out, record.failures);
+    out += ",\"updatedAt\":";
+    appendNumber(out, record.updatedAt);
+    out += ",\"rttUs\":";
+    appendNumber(out, record.rttUs);
+    out += ",\"pong\":";
+    if (!record.hasPong) {
+        out += "null}";
+        return out;
+    }
+    out += "{\"edition\":";
+    appendJsonString(out, StatusRecord::view(record.edition));
+    out += ",\"motd\":";
+    appendJsonString(out, StatusRecord::view(record.motd));
+    out += ",\"subMotd\":";
+    appendJsonString(out, StatusRecord::view(record.subMotd));
+    out += ",\"protocol\":";
+    appendNumber(out, record.protocol);
+    out += ",\"version\":";
+    appendJsonString(out, StatusRecord::view(record.version));
+    out += ",\"players\":{\"online\":";
+    appendNumber(out, record.online);
+    out += ",\"max\":";
+    appendNumber(out, record.max);
+    out += "},\"gameMode\":";
+    appendJsonString(out, StatusRecord::view(record.gameMode));
+    out += ",\"gameModeId\":";
+    appendNumber(out, record.gameModeId);
+    out += ",\"portV4\":";
+    appendNumber(out, record.portV4);
+    out += ",\"portV6\":";
+    appendNumber(out, record.portV6);
+    out += "}}";
+    return out;
+}
+
+CachedResponse makeResponse(std::string_view status, std::string body, std::string_view extraHeaders = {}) {
+    CachedResponse response;
+    response.head  = "HTTP/1.1 ";
+    response.head += status;
+    response.head += "\r\nContent-Type: application/json\r\nCache-Control: no-cache\r\nContent-Length: ";
+    appendNumber(response.head, body.size());
+    response.head += "\r\n";
+    response.head += extraHeaders;
+    response.body  = std::move(body);
+    return response;
+}
+
+CachedResponse makeError(std::string_view status, std::string_view extraHeaders = {}) {
+    std::string body = "{\"error\":";
+    appendJsonString(body, status);
+    body += '}';
+    return makeResponse(status, std::move(body), extraHeaders);
+}
+
+#ifndef _WIN32
+// A stale socket file would make bind() fail, but whatever else sits at the configured path is not ours to delete.
+void removeSocketFile(const std::string& path) noexcept {
+    struct stat info;
+    if (::lstat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) ::unlink(path.c_str());
+}
+#endif
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) noexcept {
+    return std::ranges::equal(a, b, [](char x, char y) {
+        return (x >= 'A' && x <= 'Z' ? x + 32 : x) == (y >= 'A' && y <= 'Z' ? y + 32 : y);
+    });
+}
+
+class StatusServerImpl {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    StatusServerImpl(std::shared_ptr<const StatusTable> table, const StatusServerOptions& options)
+    : mTable(std::move(table)),
+      mOptions(options),
+      mWake("status server"),
+      mInvalidations(STATUS_INVALIDATION_QUEUE),
+      mBadRequest(makeError("400 Bad Request")),
+      mNotFound(makeError("404 Not Found")),
+      mNotAllowed(makeError("405 Method Not Allowed", "Allow: GET, HEAD\r\n")),
+      mTooLarge(makeError("431 Request Header Fields Too Large")) {
+        if (!mTable) throw MotdException{"Status server needs a status table"};
+        ensureSocketsInitialized();
+        if (mOptions.unixPath.empty()) {
+            listenTcp();
+        } else {
+            listenUnix();
+        }
+        mThread = std::thread{[this] { run(); }};
+    }
+
+    ~StatusServerImpl() {
+        mStopping.store(true, std::memory_order_relaxed);
+        mWake.wake();
+        mThread.join();
+#ifndef _WIN32
+        if (!mOptions.unixPath.empty()) removeSocketFile(mOptions.unixPath);
+#endif
+    }
+
+    StatusServerImpl(const StatusServerImpl&)            = delete;
+    StatusServerImpl& operator=(const StatusServerImpl&) = delete;
+
+    void invalidate(uint64_t id) {
+        if (!mInvalidations.tryPush(id)) mInvalidateAll.store(true, std::memory_order_release);
+        wake();
+    }
+
+    void invalidateAll() {
+        mInvalidateAll.store(true, std::memory_order_release);
+        wake();
+    }
+
+    [[nodiscard]] uint16_t port() const noexcept { return mPort; }
+
+private:
+    struct Connection {
+        SocketHandle      socket;
+        std::string       input;
+        // Bytes a previous send could not take; responses queue behind them.
+        std::string       output;
+        bool              closing = false;
+        Clock::time_point lastActive;
+    };
+
+    void listenTcp() {
+        const auto endpoint = Endpoint::parse(mOptions.host, mOptions.port);
+        if (!endpoint) throw MotdException{std::format("Status server address must be numeric: {}", mOptions.host)};
+
+        sockaddr_storage storage;
+        socklen_t        length = toSockaddr(*endpoint, storage);
+        mListen                 = SocketHandle{socket(storage.ss_family, SOCK_STREAM, IPPROTO_TCP)};
+        if (!mListen) throw MotdException{"Failed to create the status server socket"};
+#ifndef _WIN32
+        const int reuse = 1;
+        setsockopt(mListen, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+#endif
+        if (bind(mListen, reinterpret_cast<const sockaddr*>(&storage), length) == SOCKET_ERROR_VALUE
+            || listen(mListen, SOMAXCONN) == SOCKET_ERROR_VALUE || !setNonBlocking(mListen)
+            || getsockname(mListen, reinterpret_cast<sockaddr*>(&storage), &length) == SOCKET_ERROR_VALUE) {
+            throw MotdException{std::format("Failed to listen on {}", endpoint->toString())};
+        }
+        mPort = ntohs(
+            storage.ss_family == AF_INET6 ? reinterpret_cast<const sockaddr_in6&>(storage).sin6_port
+                                          : reinterpret_cast<const sockaddr_in&>(storage).sin_port
+        );
+    }
+
+    void listenUnix() {
+#ifdef _WIN32
+        throw MotdException{"Unix socket status servers are not supported on Windows"};
+#else
+        sockaddr_un address{};
+        if (mOptions.unixPath.size() >= sizeof(address.sun_path)) {
+            throw MotdException{std::format("Unix socket path is too long: {}", mOptions.unixPath)};
+        }
+        address.sun_family = AF_UNIX;
+        std::ranges::copy(mOptions.unixPath, address.sun_path);
+
+        removeSocketFile(mOptions.unixPath);
+        mListen = SocketHandle{socket(AF_UNIX, SOCK_STREAM, 0)};
+        if (!mListen || bind(mListen, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+            || listen(mListen, SOMAXCONN) != 0 || !setNonBlocking(mListen)) {
+            throw MotdException{std::format("Failed to listen on {}", mOptions.unixPath)};
+        }
+#endif
+    }
+
+    void run() {
+        mInvalidateAll.store(true, std::memory_order_relaxed);
+        std::vector<PollFd> fds;
+        while (!mStopping.load(std::memory_order_relaxed)) {
+            // Cleared before the queue is drained: an invalidation that lands afterwards wakes the thread again.
+            mWakePending.store(false, std::memory_order_seq_cst);
+            refresh();
+
+            fds.clear();
+            fds.push_back(PollFd{mListen, POLL_READ_EVENT, 0});
+            fds.push_back(PollFd{mWake.handle(), POLL_READ_EVENT, 0});
+            // Blocks until a socket is ready, a wake-up arrives or the first keep-alive connection runs idle.
+            auto until = Clock::now() + STATUS_IDLE_WAIT;
+            for (const Connection& connection : mConnections) {
+                const short events = connection.output.empty() ? POLL_READ_EVENT : POLL_WRITE_EVENT;
+                fds.push_back(PollFd{connection.socket, events, 0});
+                until = std::min(until, connection.lastActive + mOptions.idleTimeout);
+            }
+            pollSockets(fds.data(), fds.size(), until - Clock::now());
+            if (fds[1].revents != 0) mWake.drain();
+
+            const auto now = Clock::now();
+            // Walk backwards so that closed connections can be swapped out without disturbing unvisited entries.
+            for (size_t i = mConnections.size(); i-- > 0;) {
+                Connection& connection = mConnections[i];
+                bool        keep       = true;
+                if (fds[i + 2].revents != 0) {
+                    connection.lastActive = now;
+                    keep                  = (connection.output.empty() || flush(connection)) && receive(connection);
+                } else {
+                    keep = now - connection.lastActive < mOptions.idleTimeout;
+                }
+                if (!keep || (connection.closing && connection.output.empty())) {
+                    std::swap(connection, mConnections.back());
+                    mConnections.pop_back();
+                }
+            }
+            if (fds[0].revents != 0) accept(now);
+        }
+    }
+
+    // One datagram per batch of invalidations; the server thread clears the flag before it looks at the queue.
+    void wake() noexcept {
+        if (!mWakePending.exchange(true, std::memory_order_seq_cst)) mWake.wake();
+    }
+
+    // Applies pending invalidations; runs on the server thread, which owns every cached response.
+    void refresh() {
+        if (mInvalidateAll.exchange(false, std::memory_order_acquire)) {
+            mResponses.clear();
+            for (size_t i = 0; i < mTable->slots(); ++i) {
+                if (const auto record = mTable->readSlot(i)) render(*record);
+            }
+            mListDirty = true;
+        }
+        uint64_t id;
+        while (mInvalidations.tryPop(id)) {
+            if (const auto record = mTable->read(id)) {
+                render(*record);
+            } else {
+                mResponses.erase(id);
+            }
+            mListDirty = true;
+        }
+    }
+
+    void render(const StatusRecord& record) {
+        mResponses.insert_or_assign(record.id, makeResponse("200 OK", renderStatus(record)));
+    }
+
+    const CachedResponse& list() {
+        if (mListDirty) {
+            std::string body = "[";
+            for (const auto& [id, response] : mResponses) {
+                if (body.size() > 1) body += ',';
+                body += response.body;
+            }
+            body       += ']';
+            mList       = makeResponse("200 OK", std::move(body));
+            mListDirty  = false;
+        }
+        return mList;
+    }
+
+    void accept(Clock::time_point now) {
+        for (;;) {
+            SocketHandle socket{::accept(mListen, nullptr, nullptr)};
+            if (!socket) return;
+            if (mConnections.size() >= mOptions.maxConnections || !setNonBlocking(socket)) continue;
+            suppressSigPipe(socket);
+            if (mOptions.unixPath.empty()) {
+                const int noDelay = 1;
+                setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+            }
+            mConnections.push_back(Connection{std::move(socket), {}, {}, false, now});
+        }
+    }
+
+    // Reads what is available and answers complete requests; false closes the connection. Both buffers are bounded:
+    // reading stops once a request's worth of input is queued, and parsing once the client falls behind on output.
+    // The rest is picked up after the output drains.
+    bool receive(Connection& connection) {
+        std::array<char, 4096> buffer;
+        while (connection.input.size() <= STATUS_MAX_REQUEST) {
+            const auto received = recv(connection.socket, buffer.data(), static_cast<int>(buffer.size()), 0);
+            if (received == 0) return false;
+            if (received < 0) {
+                if (!lastErrorWouldBlock()) return false;
+                break;
+            }
+            connection.input.append(buffer.data(), static_cast<size_t>(received));
+        }
+
+        while (!connection.closing && connection.output.size() < STATUS_MAX_OUTPUT) {
+            const size_t end = connection.input.find("\r\n\r\n");
+            if (end == std::string::npos) {
+                if (connection.input.size() > STATUS_MAX_REQUEST) return respond(connection, mTooLarge, false, true);
+                break;
+            }
+            const bool keep = handle(connection, std::string_view{connection.input}.substr(0, end));
+            connection.input.erase(0, end + 4);
+            if (!keep) return false;
+        }
+        return true;
+    }
+
+    bool handle(Connection& connection, std::string_view request) {
+        const size_t           lineEnd = std::min(request.find("\r\n"), request.size());
+        const std::string_view line    = request.substr(0, lineEnd);
+        const size_t           first   = line.find(' ');
+        const size_t           second  = line.find(' ', first + 1);
+        if (first == std::string_view::npos || second == std::string_view::npos) {
+            return respond(connection, mBadRequest, false, true);
+        }
+        const std::string_view method  = line.substr(0, first);
+        std::string_view       target  = line.substr(first + 1, second - first - 1);
+        const std::string_view version = line.substr(second + 1);
+        if (!version.starts_with("HTTP/1.")) return respond(connection, mBadRequest, false, true);
+
+        bool keepAlive = version == "HTTP/1.1";
+        for (std::string_view rest = request.substr(lineEnd); !rest.empty();) {
+            rest                         = rest.substr(std::min<size_t>(2, rest.size()));
+            const std::string_view field = rest.substr(0, rest.find("\r\n"));
+            rest                         = rest.substr(field.size());
+
+            const size_t colon = field.find(':');
+            if (colon == std::string_view::npos) continue;
+            const std::string_view name  = field.substr(0, colon);
+            std::string_view       value = field.substr(colon + 1);
+            value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+            if (equalsIgnoreCase(name, "connection")) {
+                if (equalsIgnoreCase(value, "close")) keepAlive = false;
+                if (equalsIgnoreCase(value, "keep-alive")) keepAlive = true;
+            } else if ((equalsIgnoreCase(name, "content-length") && value != "0")
+                       || equalsIgnoreCase(name, "transfer-encoding")) {
+                // Request bodies are never expected; refusing them keeps the framing simple.
+                return respond(connection, mBadRequest, false, true);
+            }
+        }
+
+        const bool head = method == "HEAD";
+        if (!head && method != "GET") return respond(connection, mNotAllowed, false, !keepAlive);
+
+        target = target.substr(0, target.find('?'));
+        if (target == "/targets" || target == "/targets/") return respond(connection, list(), head, !keepAlive);
+
+        constexpr std::string_view PREFIX = "/targets/";
+        uint64_t                   id     = 0;
+        if (target.starts_with(PREFIX)) {
+            const auto digits = target.substr(PREFIX.size());
+            const auto result = std::from_chars(digits.data(), digits.data() + digits.size(), id);
+            if (result.ec == std::errc{} && result.ptr == digits.data() + digits.size()) {
+                if (const auto it = mResponses.find(id); it != mResponses.end()) {
+                    return respond(connection, it->second, head, !keepAlive);
+                }
+            }
+        }
+        return respond(connection, mNotFound, head, !keepAlive);
+    }
+
+    // Sends a cached response in one gather write, queueing whatever the socket does not take.
+    bool respond(Connection& connection, const CachedResponse& response, bool head, bool close) {
+        const std::array<std::string_view, 3> parts{
+            response.head,
+            close ? CONNECTION_CLOSE : CONNECTION_KEEP_ALIVE,
+            head ? std::string_view{} : std::string_view{response.body}
+        };
+        connection.closing = close;
+
+        size_t sent = 0;
+        if (connection.output.empty()) {
+            const int64_t result = sendParts(connection.socket, parts);
+            if (result < 0 && !lastErrorWouldBlock()) return false;
+            sent = static_cast<size_t>(std::max<int64_t>(result, 0));
+        }
+        for (const std::string_view part : parts) {
+            const size_t skip = std::min(sent, part.size());
+            connection.output.append(part.substr(skip));
+            sent -= skip;
+        }
+        return true;
+    }
+
+    bool flush(Connection& connection) {
+        const std::array<std::string_view, 1> parts{connection.output};
+        const int64_t                         result = sendParts(connection.socket, parts);
+        if (result < 0) return lastErrorWouldBlock();
+        connection.output.erase(0, static_cast<size_t>(result));
+        return true;
+    }
+
+    std::shared_ptr<const StatusTable> mTable;
+    StatusServerOptions                mOptions;
+    SocketHandle                       mListen{INVALID_SOCKET_VALUE};
+    uint16_t                           mPort = 0;
+    std::atomic<bool>                  mStopping{false};
+    WakeSocket                         mWake;
+    std::atomic<bool>                  mWakePending{false};
+
+    MpmcQueue<uint64_t> mInvalidations;
+    std::atomic<bool>   mInvalidateAll{false};
+
+    // Owned by the server thread.
+    std::vector<Connection>            mConnections;
+    std::map<uint64_t, CachedResponse> mResponses;
+    CachedResponse                     mList;
+    bool                               mListDirty = true;
+    const CachedResponse               mBadRequest;
+    const CachedResponse               mNotFound;
+    const CachedResponse               mNotAllowed;
+    const CachedResponse               mTooLarge;
+
+    std::thread mThread;
+};
+
+} // namespace detail
+
+StatusServer::StatusServer(std::shared_ptr<const StatusTable> table, const StatusServerOptions& options)
+: mImpl(std::make_unique<detail::StatusServerImpl>(std::move(table), options)) {}
+
+StatusServer::~StatusServer() = default;
+
+void StatusServer::invalidate(uint64_t id) { mImpl->invalidate(id); }
+
+void StatusServer::invalidateAll() { mImpl->invalidateAll(); }
+
+uint16_t StatusServer::port() const noexcept { return mImpl->port(); }
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,192 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/StatusTable.hpp"
+#include "detail/SharedMemory.hpp"
+#include "detail/Socket.hpp"
+#include "detail/StatusSlot.hpp"
+#include <algorithm>
+#include <memory>
+#include <new>
+
+namespace motdpe {
+
+namespace detail {
+
+template <size_t N>
+void copyText(std::array<char, N>& field, std::string_view text) noexcept {
+    size_t size = std::min(text.size(), N);
+    // Never cut a multi-byte UTF-8 sequence in half.
+    if (size < text.size()) {
+        while (size > 0 && (static_cast<uint8_t>(text[size]) & 0xc0) == 0x80) --size;
+    }
+    std::ranges::fill(std::copy_n(text.begin(), size, field.begin()), field.end(), '\0');
+}
+
+inline size_t statusRegionSize(size_t slotCount) noexcept {
+    return sizeof(StatusHeader) + slotCount * sizeof(StatusSlot);
+}
+
+// An existing region may be replaced once its publisher closed it or died. One that is not a finished status region
+// of this layout is left by a publisher that crashed while creating it, or by an older build.
+bool statusRegionStale(const void* data, size_t size) {
+    if (size < sizeof(StatusHeader)) return true;
+    const auto* header = static_cast<const StatusHeader*>(data);
+    if (header->version.load(std::memory_order_acquire) != STATUS_VERSION || header->magic != STATUS_MAGIC) return true;
+    return header->closed.load(std::memory_order_acquire) != 0 || !SharedMemory::processAlive(header->owner);
+}
+
+} // namespace detail
+
+void StatusRecord::setPong(const Pong& pong) noexcept {
+    hasPong    = true;
+    protocol   = pong.protocol;
+    online     = pong.online;
+    max        = pong.max;
+    gameModeId = pong.gameModeId;
+    portV4     = pong.portV4;
+    portV6     = pong.portV6;
+    detail::copyText(edition, pong.edition);
+    detail::copyText(version, pong.version);
+    detail::copyText(gameMode, pong.gameMode);
+    detail::copyText(motd, pong.motd);
+    detail::copyText(subMotd, pong.subMotd);
+}
+
+StatusTable::StatusTable(size_t capacity)
+: mOwnHeader(std::make_unique<detail::StatusHeader>()),
+  mOwnSlots(std::make_unique<detail::StatusSlot[]>(detail::statusSlots(capacity))) {
+    initialize(mOwnHeader.get(), mOwnSlots.get(), detail::statusSlots(capacity));
+}
+
+StatusTable::StatusTable(std::string_view sharedName, size_t capacity) {
+    const size_t slotCount = detail::statusSlots(capacity);
+    mShared = std::make_unique<detail::SharedMemory>(
+        detail::SharedMemory::create(sharedName, detail::statusRegionSize(slotCount), detail::statusRegionStale)
+    );
+    // The region is zero-filled, which is the initial state of every header field and slot.
+    auto* header  = new (mShared->data()) detail::StatusHeader{};
+    auto* slots   = reinterpret_cast<detail::StatusSlot*>(header + 1);
+    header->owner = detail::SharedMemory::currentProcessId();
+    std::uninitialized_default_construct_n(slots, slotCount);
+    initialize(header, slots, slotCount);
+}
+
+StatusTable::~StatusTable() {
+    if (mShared) mHeader->closed.store(1, std::memory_order_release);
+}
+
+void StatusTable::initialize(detail::StatusHeader* header, detail::StatusSlot* slots, size_t slotCount) noexcept {
+    mHeader = header;
+    mSlots  = slots;
+    mMask   = slotCount - 1;
+
+    mHeader->magic      = detail::STATUS_MAGIC;
+    mHeader->byteOrder  = detail::STATUS_BYTE_ORDER;
+    mHeader->recordSize = sizeof(StatusRecord);
+    mHeader->slotSize   = sizeof(detail::StatusSlot);
+    mHeader->slotCount  = slotCount;
+    mHeader->version.store(detail::STATUS_VERSION, std::memory_order_release);
+}
+
+bool StatusTable::publish(const StatusRecord& record) noexcept {
+    if (record.id == detail::STATUS_EMPTY || record.id == detail::STATUS_ERASED) return false;
+
+    detail::StatusSlot* reusable = nullptr;
+    for (size_t i = 0, index = detail::statusHome(record.id, mMask); i <= mMask; ++i, index = (index + 1) & mMask) {
+        detail::StatusSlot& slot = mSlots[index];
+        const uint64_t      key  = slot.key.load(std::memory_order_relaxed);
+        if (key == record.id) {
+            detail::statusStore(slot, record);
+            return true;
+        }
+        if (key == detail::STATUS_ERASED && !reusable) reusable = &slot;
+        if (key == detail::STATUS_EMPTY) {
+            if (!reusable) reusable = &slot;
+            break;
+        }
+    }
+    if (!reusable) {
+        mRejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // The record is in place before the key makes the slot visible under the new id.
+    detail::statusStore(*reusable, record);
+    reusable->key.store(record.id, std::memory_order_release);
+    mHeader->size.store(mHeader->size.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return true;
+}
+
+void StatusTable::erase(uint64_t id) noexcept {
+    const size_t index = detail::statusIndexOf(mSlots, mMask, id);
+    if (index > mMask) return;
+    mSlots[index].key.store(detail::STATUS_ERASED, std::memory_order_release);
+    mHeader->size.store(mHeader->size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+
+    // A tombstone followed by an empty slot ends no probe sequence of a live id, so it and the tombstones right before
+    // it can become empty again. Without this, add/remove churn fills the table with tombstones and lookups of
+    // missing ids probe every slot. Readers racing with this stop earlier, past which no live id lies anyway.
+    if (mSlots[(index + 1) & mMask].key.load(std::memory_order_relaxed) != detail::STATUS_EMPTY) return;
+    for (size_t i = index; mSlots[i].key.load(std::memory_order_relaxed) == detail::STATUS_ERASED;) {
+        mSlots[i].key.store(detail::STATUS_EMPTY, std::memory_order_release);
+        i = (i - 1) & mMask;
+    }
+}
+
+std::optional<StatusRecord> StatusTable::read(uint64_t id) const noexcept {
+    return detail::statusRead(mSlots, mMask, id);
+}
+
+std::optional<StatusRecord> StatusTable::readSlot(size_t index) const noexcept {
+    return detail::statusReadSlot(mSlots[index & mMask]);
+}
+
+size_t StatusTable::size() const noexcept { return mHeader->size.load(std::memory_order_relaxed); }
+
+StatusReader::StatusReader(std::string_view sharedName)
+: mRegion(std::make_unique<detail::SharedMemory>(detail::SharedMemory::openReadOnly(sharedName))) {
+    const auto invalid = [&](std::string_view reason) {
+        return detail::MotdException{std::format("Invalid status region {}: {}", sharedName, reason)};
+    };
+
+    if (mRegion->size() < sizeof(detail::StatusHeader)) throw invalid("truncated header");
+    mHeader = static_cast<const detail::StatusHeader*>(mRegion->data());
+    if (mHeader->version.load(std::memory_order_acquire) != detail::STATUS_VERSION
+        || mHeader->magic != detail::STATUS_MAGIC) {
+        throw invalid("unsupported version or unfinished region");
+    }
+    if (mHeader->byteOrder != detail::STATUS_BYTE_ORDER || mHeader->recordSize != sizeof(StatusRecord)
+        || mHeader->slotSize != sizeof(detail::StatusSlot) || !std::has_single_bit(mHeader->slotCount)) {
+        throw invalid("incompatible layout");
+    }
+    if (mHeader->slotCount > (mRegion->size() - sizeof(detail::StatusHeader)) / sizeof(detail::StatusSlot)) {
+        throw invalid("truncated slots");
+    }
+    mSlots = reinterpret_cast<const detail::StatusSlot*>(mHeader + 1);
+    mMask  = mHeader->slotCount - 1;
+}
+
+StatusReader::~StatusReader() = default;
+
+StatusReader::StatusReader(StatusReader&&) noexcept = default;
+
+StatusReader& StatusReader::operator=(StatusReader&&) noexcept = default;
+
+std::optional<StatusRecord> StatusReader::read(uint64_t id) const noexcept {
+    return detail::statusRead(mSlots, mMask, id);
+}
+
+std::optional<StatusRecord> StatusReader::readSlot(size_t index) const noexcept {
+    return detail::statusReadSlot(mSlots[index & mMask]);
+}
+
+size_t StatusReader::size() const noexcept { return mHeader->size.load(std::memory_order_relaxed); }
+
+bool StatusReader::closed() const noexcept { return mHeader->closed.load(std::memory_order_acquire) != 0; }
+
+} // namespace motdpe
\ No newline at end of file
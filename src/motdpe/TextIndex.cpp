@@ -0,0 +1,324 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "motdpe/TextIndex.hpp"
+#include "detail/PostingList.hpp"
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <numeric>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace motdpe {
+
+namespace detail {
+
+// Once the intersection is down to this many rows, checking the text directly beats decoding further posting lists.
+constexpr size_t TEXT_VERIFY_CANDIDATES = 64;
+// Posting lists this many times longer than the candidate set are not worth decoding for the intersection.
+constexpr size_t TEXT_DECODE_RATIO = 8;
+
+// Separates MOTD and sub-MOTD in the stored text; never part of a needle, so no match spans both.
+constexpr char TEXT_FIELD_SEPARATOR = '\n';
+
+inline std::string normalizeText(std::string_view text) {
+    std::string result = stripFormatting(text);
+    for (char& c : result) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        if (c == TEXT_FIELD_SEPARATOR) c = ' ';
+    }
+    return result;
+}
+
+inline uint32_t trigramAt(std::string_view text, size_t pos) noexcept {
+    return static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16
+         | static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8
+         | static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+}
+
+inline std::vector<uint32_t> trigramsOf(std::string_view text) {
+    std::vector<uint32_t> grams;
+    if (text.size() < 3) return grams;
+    grams.reserve(text.size() - 2);
+    for (size_t pos = 0; pos + 3 <= text.size(); ++pos) grams.push_back(trigramAt(text, pos));
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+// Smallest edit distance between a needle and any substring of a text. Needles of up to 64 bytes use Myers'
+// bit-parallel algorithm, a handful of word operations per text byte; longer ones fall back to Sellers' dynamic
+// programme.
+class NeedleMatcher {
+public:
+    explicit NeedleMatcher(std::string_view needle) : mNeedle(needle) {
+        if (needle.empty() || needle.size() > 64) return;
+        for (size_t i = 0; i < needle.size(); ++i) mPeq[static_cast<unsigned char>(needle[i])] |= uint64_t{1} << i;
+    }
+
+    [[nodiscard]] uint32_t distance(std::string_view text) {
+        const auto length = static_cast<uint32_t>(mNeedle.size());
+        if (length == 0) return 0;
+        if (length > 64) return sellers(text);
+
+        const uint64_t last  = uint64_t{1} << (length - 1);
+        uint64_t       pv    = ~uint64_t{0};
+        uint64_t       mv    = 0;
+        uint32_t       score = length;
+        uint32_t       best  = length;
+        for (const char c : text) {
+            const uint64_t eq = mPeq[static_cast<unsigned char>(c)];
+            const uint64_t xv = eq | mv;
+            const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t       ph = mv | ~(xh | pv);
+            uint64_t       mh = pv & xh;
+            if (ph & last) {
+                ++score;
+            } else if (mh & last) {
+                --score;
+            }
+            // A match may start anywhere in the text, so no carry enters the first row.
+            ph   <<= 1;
+            mh   <<= 1;
+            pv     = mh | ~(xv | ph);
+            mv     = ph & xv;
+            best   = std::min(best, score);
+            if (best == 0) break;
+        }
+        return best;
+    }
+
+private:
+    [[nodiscard]] uint32_t sellers(std::string_view text) {
+        mColumn.resize(mNeedle.size() + 1);
+        std::iota(mColumn.begin(), mColumn.end(), 0u);
+        uint32_t best = mColumn.back();
+        for (const char c : text) {
+            uint32_t diagonal = mColumn[0];
+            for (size_t i = 1; i <= mNeedle.size(); ++i) {
+                const uint32_t above = mColumn[i];
+                mColumn[i]           = std::min({mColumn[i] + 1, mColumn[i - 1] + 1, diagonal + (mNeedle[i - 1] != c)});
+                diagonal             = above;
+            }
+            best = std::min(best, mColumn.back());
+            if (best == 0) break;
+        }
+        return best;
+    }
+
+    std::string_view          mNeedle;
+    std::array<uint64_t, 256> mPeq{};
+    std::vector<uint32_t>     mColumn;
+};
+
+class TextIndexImpl {
+public:
+    void update(uint64_t id, std::string_view motd, std::string_view subMotd) {
+        std::string text  = normalizeText(motd);
+        text             += TEXT_FIELD_SEPARATOR;
+        text             += normalizeText(subMotd);
+
+        std::unique_lock lock{mMutex};
+        const auto [it, inserted] = mRowOf.try_emplace(id, 0);
+        if (inserted) {
+            it->second = allocate(id);
+        } else {
+            if (mDocs[it->second].text == text) return;
+            unindex(it->second);
+        }
+        mDocs[it->second].text = std::move(text);
+        for (const uint32_t gram : trigramsOf(mDocs[it->second].text)) mPostings[gram].insert(it->second);
+    }
+
+    bool erase(uint64_t id) {
+        std::unique_lock lock{mMutex};
+        const auto       it = mRowOf.find(id);
+        if (it == mRowOf.end()) return false;
+        unindex(it->second);
+        mDocs[it->second] = Doc{};
+        mFreeRows.push_back(it->second);
+        mRowOf.erase(it);
+        return true;
+    }
+
+    [[nodiscard]] std::vector<uint64_t> search(std::string_view needle, size_t limit) const {
+        const std::string     normalized = normalizeText(needle);
+        std::vector<uint64_t> ids;
+        if (limit == 0) return ids;
+
+        std::shared_lock lock{mMutex};
+        const auto       collect = [&](uint32_t row) {
+            const Doc& doc = mDocs[row];
+            if (doc.live && doc.text.find(normalized) != std::string::npos) ids.push_back(doc.id);
+            return ids.size() < limit;
+        };
+
+        if (normalized.size() < 3) {
+            for (uint32_t row = 0; row < mDocs.size() && collect(row); ++row) {}
+            return ids;
+        }
+        std::vector<uint32_t> rows;
+        candidates(normalized, rows);
+        for (const uint32_t row : rows) {
+            if (!collect(row)) break;
+        }
+        return ids;
+    }
+
+    // Searches with growing edit budgets so that closer matches are found first and the search stops once `limit`
+    // matches are known. By the pigeonhole principle, a text within d edits of the needle contains one of d + 1
+    // disjoint pieces of it exactly, so each round only checks texts found by an exact search for one of its pieces.
+    [[nodiscard]] std::vector<TextMatch> searchFuzzy(std::string_view needle, uint32_t maxEdits, size_t limit) const {
+        const std::string      normalized = normalizeText(needle);
+        std::vector<TextMatch> matches;
+        if (limit == 0) return matches;
+        // Every text is within the needle's length of it, so a larger budget finds nothing new and, at UINT32_MAX,
+        // would never end the loop below.
+        maxEdits = static_cast<uint32_t>(std::min<size_t>(maxEdits, normalized.size()));
+
+        std::shared_lock                       lock{mMutex};
+        NeedleMatcher                          matcher{normalized};
+        std::unordered_map<uint32_t, uint32_t> distances;
+        std::vector<uint32_t>                  rows;
+        std::vector<uint32_t>                  pieceRows;
+        const auto                             check = [&](uint32_t row, uint32_t edits) {
+            const Doc& doc = mDocs[row];
+            if (!doc.live) return true;
+            // Rows checked in an earlier round were reported then if they were close enough.
+            const auto [it, inserted] = distances.try_emplace(row, 0);
+            if (inserted) it->second = matcher.distance(doc.text);
+            if (it->second == edits) matches.push_back(TextMatch{doc.id, edits});
+            return matches.size() < limit;
+        };
+
+        for (uint32_t edits = 0; edits <= maxEdits; ++edits) {
+            const size_t pieces = size_t{edits} + 1;
+            const size_t length = normalized.size() / pieces;
+            // Pieces without a trigram cannot be looked up.
+            if (length < 3) {
+                for (uint32_t row = 0; row < mDocs.size(); ++row) {
+                    if (!check(row, edits)) return matches;
+                }
+                continue;
+            }
+            rows.clear();
+            for (size_t i = 0; i < pieces; ++i) {
+                const size_t begin = i * length;
+                const size_t end   = i + 1 == pieces ? normalized.size() : begin + length;
+                candidates(std::string_view{normalized}.substr(begin, end - begin), pieceRows);
+                rows.insert(rows.end(), pieceRows.begin(), pieceRows.end());
+            }
+            std::sort(rows.begin(), rows.end());
+            rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+            for (const uint32_t row : rows) {
+                if (!check(row, edits)) return matches;
+            }
+        }
+        return matches;
+    }
+
+    [[nodiscard]] size_t size() const {
+        std::shared_lock lock{mMutex};
+        return mRowOf.size();
+    }
+
+    [[nodiscard]] size_t memoryBytes() const {
+        std::shared_lock lock{mMutex};
+        size_t           total = mDocs.capacity() * sizeof(Doc);
+        for (const Doc& doc : mDocs) total += doc.text.capacity();
+        for (const auto& [gram, list] : mPostings) total += sizeof(gram) + sizeof(list) + list.memoryBytes();
+        return total;
+    }
+
+private:
+    struct Doc {
+        uint64_t    id   = 0;
+        bool        live = false;
+        std::string text;
+    };
+
+    uint32_t allocate(uint64_t id) {
+        uint32_t row;
+        if (mFreeRows.empty()) {
+            row = static_cast<uint32_t>(mDocs.size());
+            mDocs.emplace_back();
+        } else {
+            row = mFreeRows.back();
+            mFreeRows.pop_back();
+        }
+        mDocs[row].id   = id;
+        mDocs[row].live = true;
+        return row;
+    }
+
+    void unindex(uint32_t row) {
+        for (const uint32_t gram : trigramsOf(mDocs[row].text)) {
+            const auto it = mPostings.find(gram);
+            it->second.erase(row);
+            if (it->second.empty()) mPostings.erase(it);
+        }
+    }
+
+    // Rows that may contain `text` (at least three bytes), ascending: the intersection of its trigrams' posting lists,
+    // rarest first. Lists much longer than the remaining candidates are left out, since checking the candidates' text
+    // is cheaper than decoding them.
+    void candidates(std::string_view text, std::vector<uint32_t>& rows) const {
+        rows.clear();
+        std::vector<const PostingList*> lists;
+        for (const uint32_t gram : trigramsOf(text)) {
+            const auto it = mPostings.find(gram);
+            if (it == mPostings.end()) return;
+            lists.push_back(&it->second);
+        }
+        std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) { return a->size() < b->size(); });
+
+        std::vector<uint32_t> other;
+        lists.front()->decode(rows);
+        for (size_t i = 1; i < lists.size() && rows.size() > TEXT_VERIFY_CANDIDATES; ++i) {
+            if (lists[i]->size() > rows.size() * TEXT_DECODE_RATIO) break;
+            lists[i]->decode(other);
+            const auto end = std::set_intersection(rows.begin(), rows.end(), other.begin(), other.end(), rows.begin());
+            rows.erase(end, rows.end());
+        }
+    }
+
+    mutable std::shared_mutex                 mMutex;
+    std::vector<Doc>                          mDocs;
+    std::vector<uint32_t>                     mFreeRows;
+    std::unordered_map<uint64_t, uint32_t>    mRowOf;
+    std::unordered_map<uint32_t, PostingList> mPostings;
+};
+
+} // namespace detail
+
+TextIndex::TextIndex() : mImpl(std::make_unique<detail::TextIndexImpl>()) {}
+
+TextIndex::~TextIndex() = default;
+
+void TextIndex::update(uint64_t id, const Pong& pong) { mImpl->update(id, pong.motd, pong.subMotd); }
+
+void TextIndex::update(uint64_t id, std::string_view motd, std::string_view subMotd) {
+    mImpl->update(id, motd, subMotd);
+}
+
+bool TextIndex::erase(uint64_t id) { return mImpl->erase(id); }
+
+std::vector<uint64_t> TextIndex::search(std::string_view needle, size_t limit) const {
+    return mImpl->search(needle, limit);
+}
+
+std::vector<TextMatch> TextIndex::searchFuzzy(std::string_view needle, uint32_t maxEdits, size_t limit) const {
+    return mImpl->searchFuzzy(needle, maxEdits, limit);
+}
+
+size_t TextIndex::size() const { return mImpl->size(); }
+
+size_t TextIndex::memoryBytes() const { return mImpl->memoryBytes(); }
+
+} // namespace motdpe
\ No newline at end of file
@@ -0,0 +1,71 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace motdpe::detail {
+
+// Uncompressed bitset over dense row numbers that grows on demand; bits past the end read as clear. Intersections
+// run a word at a time, so filtering 100k rows by one attribute is about 1.6k AND instructions.
+class Bitmap {
+public:
+    void set(size_t bit) {
+        const size_t word = bit / 64;
+        if (word >= mWords.size()) mWords.resize(word + 1);
+        mWords[word] |= uint64_t{1} << (bit % 64);
+    }
+
+    void reset(size_t bit) noexcept {
+        const size_t word = bit / 64;
+        if (word < mWords.size()) mWords[word] &= ~(uint64_t{1} << (bit % 64));
+    }
+
+    void assign(size_t bit, bool value) {
+        if (value) {
+            set(bit);
+        } else {
+            reset(bit);
+        }
+    }
+
+    [[nodiscard]] bool test(size_t bit) const noexcept {
+        const size_t word = bit / 64;
+        return word < mWords.size() && (mWords[word] >> (bit % 64) & 1) != 0;
+    }
+
+    [[nodiscard]] size_t count() const noexcept {
+        size_t total = 0;
+        for (const uint64_t word : mWords) total += static_cast<size_t>(std::popcount(word));
+        return total;
+    }
+
+    // Keeps only the bits that are also set in `other`.
+    void intersect(const Bitmap& other) noexcept {
+        if (mWords.size() > other.mWords.size()) mWords.resize(other.mWords.size());
+        for (size_t i = 0; i < mWords.size(); ++i) mWords[i] &= other.mWords[i];
+    }
+
+    // Calls `visit(size_t)` for every set bit in ascending order.
+    template <typename Visit>
+    void forEach(Visit&& visit) const {
+        for (size_t i = 0; i < mWords.size(); ++i) {
+            for (uint64_t word = mWords[i]; word != 0; word &= word - 1) {
+                visit(i * 64 + static_cast<size_t>(std::countr_zero(word)));
+            }
+        }
+    }
+
+private:
+    std::vector<uint64_t> mWords;
+};
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -0,0 +1,66 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace motdpe::detail {
+
+// Epoch-numbered list of published batches with one lock-free reader. Writers (serialized by the caller) append a
+// batch and reclaim every batch the reader has moved past; the reader only performs atomic loads and one release
+// store per batch, so it never blocks on a writer.
+template <typename Batch>
+class ChangeLog {
+public:
+    ChangeLog() : mHead(new Node{}), mTail(mHead), mCursor(mHead) {}
+
+    ~ChangeLog() {
+        while (mHead) delete std::exchange(mHead, mHead->next.load(std::memory_order_relaxed));
+    }
+
+    ChangeLog(const ChangeLog&)            = delete;
+    ChangeLog& operator=(const ChangeLog&) = delete;
+
+    // Writer side; calls must be serialized. Returns the batch's epoch.
+    uint64_t publish(Batch batch) {
+        auto* node = new Node{mTail->epoch + 1, std::move(batch)};
+        mTail->next.store(node, std::memory_order_release);
+        mTail = node;
+
+        // The reader's cursor node and everything after it stay alive.
+        const uint64_t consumed = mConsumed.load(std::memory_order_acquire);
+        while (mHead->epoch < consumed) delete std::exchange(mHead, mHead->next.load(std::memory_order_relaxed));
+        return mTail->epoch;
+    }
+
+    // Reader side: the next unconsumed batch, or null. The pointer stays valid until the following call.
+    const Batch* next() noexcept {
+        Node* node = mCursor->next.load(std::memory_order_acquire);
+        if (!node) return nullptr;
+        mCursor = node;
+        mConsumed.store(node->epoch, std::memory_order_release);
+        return &node->batch;
+    }
+
+    [[nodiscard]] uint64_t consumed() const noexcept { return mConsumed.load(std::memory_order_acquire); }
+
+private:
+    struct Node {
+        uint64_t           epoch = 0;
+        Batch              batch{};
+        std::atomic<Node*> next{nullptr};
+    };
+
+    Node*                 mHead;
+    Node*                 mTail;
+    Node*                 mCursor;
+    std::atomic<uint64_t> mConsumed{0};
+};
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -0,0 +1,105 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace motdpe::detail {
+
+// Ready queue of the monitor: strict priority between lanes, deficit round-robin between tenants inside a lane. Every
+// ping costs one unit and a tenant earns `weight` units per round, so a tenant with a huge backlog gets its weighted
+// share of the packet budget and no more.
+template <size_t Lanes>
+class FairQueue {
+public:
+    // Tenants are dense indices; unknown ones are added with weight 1.
+    void setWeight(uint32_t tenant, uint32_t weight) {
+        ensureTenant(tenant);
+        mWeights[tenant] = std::max<uint32_t>(weight, 1);
+    }
+
+    void push(size_t lane, uint32_t tenant, uint64_t item) {
+        ensureTenant(tenant);
+        Lane& queue   = mLanes[lane];
+        auto& backlog = queue.backlogs[tenant];
+        if (backlog.items.empty()) queue.active.push_back(tenant);
+        backlog.items.push_back(item);
+        ++mSize;
+    }
+
+    // Item that should be served next; it stays queued until pop().
+    [[nodiscard]] std::optional<uint64_t> peek() {
+        for (Lane& lane : mLanes) {
+            if (lane.active.empty()) continue;
+            auto& backlog = lane.backlogs[lane.active.front()];
+            if (!lane.charged) {
+                backlog.deficit += mWeights[lane.active.front()];
+                lane.charged     = true;
+            }
+            return backlog.items.front();
+        }
+        return std::nullopt;
+    }
+
+    // Removes the item returned by the last peek(); nothing may be pushed in between.
+    void pop() {
+        for (Lane& lane : mLanes) {
+            if (lane.active.empty()) continue;
+            const uint32_t tenant  = lane.active.front();
+            auto&          backlog = lane.backlogs[tenant];
+            backlog.items.pop_front();
+            --backlog.deficit;
+            --mSize;
+
+            if (backlog.items.empty()) {
+                backlog.deficit = 0;
+                lane.active.pop_front();
+                lane.charged = false;
+            } else if (backlog.deficit == 0) {
+                lane.active.pop_front();
+                lane.active.push_back(tenant);
+                lane.charged = false;
+            }
+            return;
+        }
+    }
+
+    [[nodiscard]] bool   empty() const noexcept { return mSize == 0; }
+    [[nodiscard]] size_t size() const noexcept { return mSize; }
+
+private:
+    struct Backlog {
+        std::deque<uint64_t> items;
+        uint64_t             deficit = 0;
+    };
+
+    struct Lane {
+        std::vector<Backlog> backlogs;
+        // Tenants with a backlog, in service order; the front one is being served.
+        std::deque<uint32_t> active;
+        // Whether the front tenant already received its quantum for the current turn.
+        bool charged = false;
+    };
+
+    void ensureTenant(uint32_t tenant) {
+        if (tenant < mWeights.size()) return;
+        mWeights.resize(tenant + 1, 1);
+        for (Lane& lane : mLanes) lane.backlogs.resize(tenant + 1);
+    }
+
+    std::array<Lane, Lanes> mLanes;
+    std::vector<uint32_t>   mWeights;
+    size_t                  mSize = 0;
+};
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -0,0 +1,136 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace motdpe::detail {
+
+// Minimal FlatBuffers encoder for the handful of schemas the Arrow IPC exporter needs, so the library does not depend
+// on flatc. Objects are written front to back: a table is written first and the objects it references are appended
+// after it, which keeps every offset pointing forward as the format requires. All values are little-endian.
+class FlatBufferBuilder {
+public:
+    // Appends one object (table, string or vector) and returns its position.
+    using Writer = std::function<uint32_t(FlatBufferBuilder&)>;
+
+    struct Field {
+        uint16_t slot;
+        // Byte size of a scalar; 0 for a reference to an object written by `child`.
+        uint8_t  size  = 0;
+        uint64_t value = 0;
+        Writer   child;
+    };
+
+    template <typename T>
+    static Field scalar(uint16_t slot, T value) {
+        return Field{slot, static_cast<uint8_t>(sizeof(T)), static_cast<uint64_t>(value), {}};
+    }
+
+    static Field object(uint16_t slot, Writer child) { return Field{slot, 0, 0, std::move(child)}; }
+
+    uint32_t table(std::span<const Field> fields) {
+        // Inline layout relative to the table start, which is 8-byte aligned.
+        std::vector<uint16_t> at(fields.size());
+        uint16_t              slots = 0;
+        size_t                end   = sizeof(int32_t);
+        for (size_t i = 0; i < fields.size(); ++i) {
+            const size_t size = fields[i].size ? fields[i].size : sizeof(uint32_t);
+            end               = (end + size - 1) / size * size;
+            at[i]             = static_cast<uint16_t>(end);
+            end              += size;
+            slots             = std::max<uint16_t>(slots, fields[i].slot + 1);
+        }
+
+        align(sizeof(uint16_t));
+        const auto vtable = static_cast<uint32_t>(mBuffer.size());
+        std::vector<uint16_t> entries(slots);
+        for (size_t i = 0; i < fields.size(); ++i) entries[fields[i].slot] = at[i];
+        put(sizeof(uint16_t) * (2 + slots), sizeof(uint16_t));
+        put(end, sizeof(uint16_t));
+        for (const uint16_t entry : entries) put(entry, sizeof(uint16_t));
+
+        align(sizeof(uint64_t));
+        const auto start = static_cast<uint32_t>(mBuffer.size());
+        put(start - vtable, sizeof(int32_t));
+        for (size_t i = 0; i < fields.size(); ++i) {
+            mBuffer.resize(start + at[i]);
+            put(fields[i].value, fields[i].size ? fields[i].size : sizeof(uint32_t));
+        }
+        mBuffer.resize(start + end);
+
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (fields[i].size) continue;
+            const uint32_t reference = start + at[i];
+            patch(reference, fields[i].child(*this) - reference);
+        }
+        return start;
+    }
+
+    uint32_t string(std::string_view text) {
+        align(sizeof(uint32_t));
+        const auto start = static_cast<uint32_t>(mBuffer.size());
+        put(text.size(), sizeof(uint32_t));
+        mBuffer.insert(mBuffer.end(), text.begin(), text.end());
+        mBuffer.push_back(0);
+        return start;
+    }
+
+    // Vector of tables or strings.
+    uint32_t vector(std::span<const Writer> elements) {
+        align(sizeof(uint32_t));
+        const auto start = static_cast<uint32_t>(mBuffer.size());
+        put(elements.size(), sizeof(uint32_t));
+        mBuffer.resize(mBuffer.size() + elements.size() * sizeof(uint32_t));
+        for (size_t i = 0; i < elements.size(); ++i) {
+            const auto reference = static_cast<uint32_t>(start + sizeof(uint32_t) * (i + 1));
+            patch(reference, elements[i](*this) - reference);
+        }
+        return start;
+    }
+
+    // Vector of structs made of 8-byte words, `wordsPerElement` words each.
+    uint32_t structs(std::span<const uint64_t> words, size_t wordsPerElement) {
+        // The elements after the length must be 8-byte aligned.
+        while ((mBuffer.size() + sizeof(uint32_t)) % sizeof(uint64_t) != 0) mBuffer.push_back(0);
+        const auto start = static_cast<uint32_t>(mBuffer.size());
+        put(words.size() / wordsPerElement, sizeof(uint32_t));
+        for (const uint64_t word : words) put(word, sizeof(uint64_t));
+        return start;
+    }
+
+    // Encodes a buffer whose root is written by `root`, padded to a multiple of 8 bytes.
+    std::vector<uint8_t> finish(const Writer& root) {
+        mBuffer.assign(sizeof(uint32_t), 0);
+        patch(0, root(*this));
+        align(sizeof(uint64_t));
+        return std::move(mBuffer);
+    }
+
+private:
+    void align(size_t alignment) {
+        while (mBuffer.size() % alignment != 0) mBuffer.push_back(0);
+    }
+
+    void put(uint64_t value, size_t size) {
+        for (size_t i = 0; i < size; ++i) mBuffer.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    void patch(size_t at, uint32_t value) {
+        for (size_t i = 0; i < sizeof(uint32_t); ++i) mBuffer[at + i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    std::vector<uint8_t> mBuffer;
+};
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -0,0 +1,59 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace motdpe::detail {
+
+// Minimal JSON writing helpers for the status server and alert sinks; numbers use to_chars, so output does not
+// depend on the locale.
+
+template <typename T>
+inline void appendNumber(std::string& out, T value) {
+    std::array<char, 24> buffer;
+    out.append(buffer.data(), std::to_chars(buffer.data(), buffer.data() + buffer.size(), value).ptr);
+}
+
+inline void appendJsonString(std::string& out, std::string_view text) {
+    constexpr std::string_view HEX = "0123456789abcdef";
+    out += '"';
+    for (const char c : text) {
+        switch (c) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (static_cast<uint8_t>(c) < 0x20) {
+                out += "\\u00";
+                out += HEX[static_cast<uint8_t>(c) >> 4];
+                out += HEX[static_cast<uint8_t>(c) & 0xf];
+            } else {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+} // namespace motdpe::detail
\ No newline at end of file
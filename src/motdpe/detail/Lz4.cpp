@@ -0,0 +1,176 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "Lz4.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace motdpe::detail {
+
+namespace {
+
+constexpr uint32_t LZ4_MAGIC            = 0x184D2204;
+constexpr uint8_t  LZ4_FLAGS            = 0x60; // Version 01, independent blocks, no checksums or content size.
+constexpr uint8_t  LZ4_BLOCK_DESCRIPTOR = 0x40; // 64 KiB maximum block size.
+constexpr uint32_t LZ4_UNCOMPRESSED     = 0x80000000;
+
+constexpr size_t   LZ4_MIN_MATCH     = 4;
+constexpr size_t   LZ4_LAST_LITERALS = 5;  // The last five bytes of a block are always literals...
+constexpr size_t   LZ4_MF_LIMIT      = 12; // ...and no match starts in its last twelve.
+constexpr size_t   LZ4_MAX_DISTANCE  = 65535;
+constexpr unsigned LZ4_HASH_BITS     = 12;
+// Probe distance grows by one every 2^LZ4_SKIP_SHIFT misses, so incompressible data is skipped quickly.
+constexpr unsigned LZ4_SKIP_SHIFT = 6;
+
+constexpr uint32_t XXH32_PRIME1 = 0x9E3779B1;
+constexpr uint32_t XXH32_PRIME2 = 0x85EBCA77;
+constexpr uint32_t XXH32_PRIME3 = 0xC2B2AE3D;
+constexpr uint32_t XXH32_PRIME5 = 0x165667B1;
+
+// XXH32 with seed 0 of an input shorter than 16 bytes, which covers every frame descriptor.
+uint32_t shortXxh32(std::span<const uint8_t> input) noexcept {
+    uint32_t hash = XXH32_PRIME5 + static_cast<uint32_t>(input.size());
+    for (const uint8_t byte : input) {
+        hash += byte * XXH32_PRIME5;
+        hash  = std::rotl(hash, 11) * XXH32_PRIME1;
+    }
+    hash ^= hash >> 15;
+    hash *= XXH32_PRIME2;
+    hash ^= hash >> 13;
+    hash *= XXH32_PRIME3;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+void putLittle32(uint8_t* out, uint32_t value) noexcept {
+    for (size_t i = 0; i < sizeof(value); ++i) out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+uint32_t load32(const uint8_t* at) noexcept {
+    uint32_t value;
+    std::memcpy(&value, at, sizeof(value));
+    return value;
+}
+
+uint32_t hashOf(uint32_t sequence) noexcept { return (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS); }
+
+// Writes the 255-continued remainder of a length whose token nibble saturated at 15.
+uint8_t* putLength(uint8_t* out, size_t length) noexcept {
+    for (length -= 15; length >= 255; length -= 255) *out++ = 255;
+    *out++ = static_cast<uint8_t>(length);
+    return out;
+}
+
+uint8_t* putSequence(uint8_t* out, const uint8_t* literals, size_t literalLength) noexcept {
+    *out++ = static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4);
+    if (literalLength >= 15) out = putLength(out, literalLength);
+    std::memcpy(out, literals, literalLength);
+    return out + literalLength;
+}
+
+} // namespace
+
+size_t Lz4FrameEncoder::begin(uint8_t* out) const noexcept {
+    putLittle32(out, LZ4_MAGIC);
+    const uint8_t descriptor[] = {LZ4_FLAGS, LZ4_BLOCK_DESCRIPTOR};
+    out[4]                     = descriptor[0];
+    out[5]                     = descriptor[1];
+    out[6]                     = static_cast<uint8_t>(shortXxh32(descriptor) >> 8);
+    return HEADER_SIZE;
+}
+
+size_t Lz4FrameEncoder::encode(std::span<const uint8_t> input, uint8_t* out) {
+    uint8_t* cursor = out;
+    while (!input.empty()) {
+        const auto block = input.first(std::min(input.size(), BLOCK_SIZE));
+        input            = input.subspan(block.size());
+
+        uint8_t* const payload = cursor + sizeof(uint32_t);
+        size_t         size    = compressBlock(block, payload, block.size());
+        uint32_t       header  = static_cast<uint32_t>(size);
+        if (size == 0) {
+            size   = block.size();
+            header = static_cast<uint32_t>(size) | LZ4_UNCOMPRESSED;
+            std::memcpy(payload, block.data(), size);
+        }
+        putLittle32(cursor, header);
+        cursor = payload + size;
+    }
+    return static_cast<size_t>(cursor - out);
+}
+
+size_t Lz4FrameEncoder::end(uint8_t* out) const noexcept {
+    putLittle32(out, 0);
+    return END_SIZE;
+}
+
+size_t Lz4FrameEncoder::compressBlock(std::span<const uint8_t> input, uint8_t* out, size_t limit) {
+    // Token, literal length bytes, literals, offset and match length bytes of one sequence.
+    const auto fits = [&](const uint8_t* at, size_t literals, size_t match) {
+        const size_t worst = 1 + literals / 255 + 1 + literals + 2 + match / 255 + 1;
+        return static_cast<size_t>(at - out) + worst < limit;
+    };
+
+    const uint8_t* const begin  = input.data();
+    const size_t         size   = input.size();
+    uint8_t*             cursor = out;
+    size_t               anchor = 0;
+
+    if (size > LZ4_MF_LIMIT) {
+        // Blocks are independent, so positions from the previous block must not match.
+        mTable.fill(0);
+        const size_t matchLimit = size - LZ4_LAST_LITERALS;
+        const size_t searchEnd  = size - LZ4_MF_LIMIT;
+
+        size_t position = 1;
+        size_t misses   = 0;
+        while (position <= searchEnd) {
+            const uint32_t sequence  = load32(begin + position);
+            uint32_t&      slot      = mTable[hashOf(sequence)];
+            size_t         candidate = slot;
+            slot                     = static_cast<uint32_t>(position);
+
+            if (candidate >= position || position - candidate > LZ4_MAX_DISTANCE
+                || load32(begin + candidate) != sequence) {
+                position += 1 + (misses++ >> LZ4_SKIP_SHIFT);
+                continue;
+            }
+            misses = 0;
+
+            while (position > anchor && candidate > 0 && begin[position - 1] == begin[candidate - 1]) {
+                --position;
+                --candidate;
+            }
+            size_t length = LZ4_MIN_MATCH;
+            while (position + length < matchLimit && begin[position + length] == begin[candidate + length]) ++length;
+
+            const size_t literalLength = position - anchor;
+            const size_t matchLength   = length - LZ4_MIN_MATCH;
+            if (!fits(cursor, literalLength, matchLength)) return 0;
+            uint8_t&     token         = *cursor;
+            cursor                     = putSequence(cursor, begin + anchor, literalLength);
+            token                     |= static_cast<uint8_t>(std::min<size_t>(matchLength, 15));
+            const size_t distance      = position - candidate;
+            *cursor++                  = static_cast<uint8_t>(distance);
+            *cursor++                  = static_cast<uint8_t>(distance >> 8);
+            if (matchLength >= 15) cursor = putLength(cursor, matchLength);
+
+            position += length;
+            anchor    = position;
+            if (position - 2 <= searchEnd) {
+                mTable[hashOf(load32(begin + position - 2))] = static_cast<uint32_t>(position - 2);
+            }
+        }
+    }
+
+    if (!fits(cursor, size - anchor, 0)) return 0;
+    cursor = putSequence(cursor, begin + anchor, size - anchor);
+    return static_cast<size_t>(cursor - out);
+}
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -0,0 +1,46 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace motdpe::detail {
+
+// Streaming encoder for the LZ4 frame format (readable by `lz4 -d`, python-lz4 and every other LZ4 implementation).
+// Input is cut into independent 64 KiB blocks compressed with the greedy single-probe match finder of the reference
+// "fast" mode, which trades ratio for several hundred MB/s per core. Blocks that do not shrink are stored raw.
+class Lz4FrameEncoder {
+public:
+    static constexpr size_t BLOCK_SIZE  = 64 * 1024;
+    static constexpr size_t HEADER_SIZE = 7;
+    static constexpr size_t END_SIZE    = 4;
+
+    // Largest output encode() produces for `size` input bytes.
+    [[nodiscard]] static constexpr size_t bound(size_t size) noexcept {
+        const size_t blocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        return size + blocks * sizeof(uint32_t);
+    }
+
+    // Writes the frame header; returns HEADER_SIZE.
+    size_t begin(uint8_t* out) const noexcept;
+    // Writes `input` as blocks of at most BLOCK_SIZE bytes; returns the bytes written.
+    size_t encode(std::span<const uint8_t> input, uint8_t* out);
+    // Writes the end mark; returns END_SIZE.
+    size_t end(uint8_t* out) const noexcept;
+
+private:
+    // Compresses one block into `out`, stopping with 0 once the output would reach `limit` bytes; returns the
+    // compressed size.
+    size_t compressBlock(std::span<const uint8_t> input, uint8_t* out, size_t limit);
+
+    std::array<uint32_t, 4096> mTable{};
+};
+
+} // namespace motdpe::detail
\ No newline at end of file
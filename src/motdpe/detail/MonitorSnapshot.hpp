@@ -0,0 +1,78 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace motdpe::detail {
+
+// On-disk layout of a monitor snapshot: a header, fixed-stride target and weight records, then one string area that
+// records reference by offset. Every field is naturally aligned and stored in host byte order, so a loader can use
+// the file image (read or mapped) in place without parsing.
+
+constexpr std::array<char, 8> SNAPSHOT_MAGIC{'M', 'O', 'T', 'D', 'P', 'E', 'S', 'N'};
+constexpr uint32_t            SNAPSHOT_VERSION    = 1;
+constexpr uint32_t            SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+// Marks an absent time offset.
+constexpr int64_t SNAPSHOT_NO_TIME = std::numeric_limits<int64_t>::min();
+
+struct SnapshotString {
+    uint32_t offset;
+    uint32_t size;
+};
+
+struct SnapshotHeader {
+    std::array<char, 8> magic;
+    uint32_t            version;
+    uint32_t            byteOrder;
+    uint32_t            targetSize;
+    uint32_t            weightSize;
+    uint64_t            targetCount;
+    uint64_t            weightCount;
+    uint64_t            stringsSize;
+    uint64_t            nextId;
+    // Wall-clock time of the snapshot in milliseconds since the Unix epoch; restore() uses it to keep phases.
+    int64_t savedAt;
+    uint64_t reserved;
+};
+
+struct SnapshotTarget {
+    uint64_t                id;
+    std::array<uint8_t, 16> address;
+    uint16_t                port;
+    uint8_t                 ipv6;
+    uint8_t                 priority;
+    uint32_t                failures;
+    int64_t                 intervalMs;
+    int64_t                 srttUs;
+    int64_t                 rttvarUs;
+    uint32_t                rttBackoff;
+    uint32_t                reserved;
+    // Schedule relative to the snapshot time; the next due time may be negative when the target was overdue.
+    int64_t        dueMs;
+    int64_t        previousMs;
+    SnapshotString host;
+    SnapshotString tenant;
+    // Raw payload of the last pong, empty if none was received.
+    SnapshotString motd;
+};
+
+struct SnapshotWeight {
+    SnapshotString tenant;
+    uint32_t       weight;
+    uint32_t       reserved;
+};
+
+static_assert(sizeof(SnapshotHeader) == 72 && std::is_trivially_copyable_v<SnapshotHeader>);
+static_assert(sizeof(SnapshotTarget) == 104 && std::is_trivially_copyable_v<SnapshotTarget>);
+static_assert(sizeof(SnapshotWeight) == 16 && std::is_trivially_copyable_v<SnapshotWeight>);
+
+} // namespace motdpe::detail
\ No newline at end of file
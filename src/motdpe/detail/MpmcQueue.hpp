@@ -0,0 +1,101 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace motdpe::detail {
+
+// Bounded lock-free multi-producer multi-consumer ring (D. Vyukov). Each cell carries a sequence number that tells
+// producers and consumers whose turn it is, so a push or pop is one CAS on the shared index plus one release store.
+template <typename T>
+class MpmcQueue {
+public:
+    explicit MpmcQueue(size_t capacity)
+    : mCapacity(std::bit_ceil(std::max<size_t>(capacity, 2))),
+      mMask(mCapacity - 1),
+      mCells(std::make_unique<Cell[]>(mCapacity)) {
+        for (size_t i = 0; i < mCapacity; ++i) mCells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue&)            = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // Leaves `value` untouched when the queue is full.
+    bool tryPush(T& value) {
+        size_t pos = mEnqueue.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell&          cell     = mCells[pos & mMask];
+            const size_t   sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff     = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (mEnqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = mEnqueue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& value) {
+        size_t pos = mDequeue.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell&          cell     = mCells[pos & mMask];
+            const size_t   sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff     = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (mDequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.sequence.store(pos + mMask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = mDequeue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept { return mCapacity; }
+
+    // Approximate under concurrent use.
+    [[nodiscard]] size_t size() const noexcept {
+        const size_t enqueued = mEnqueue.load(std::memory_order_relaxed);
+        const size_t dequeued = mDequeue.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T                   value;
+    };
+
+    const size_t            mCapacity;
+    const size_t            mMask;
+    std::unique_ptr<Cell[]> mCells;
+
+    alignas(CACHE_LINE) std::atomic<size_t> mEnqueue{0};
+    alignas(CACHE_LINE) std::atomic<size_t> mDequeue{0};
+};
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -0,0 +1,62 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace motdpe::detail {
+
+inline constexpr uint64_t splitMix64(uint64_t x) noexcept {
+    x += 0x9E3779B97F4A7C15ull;
+    x  = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x  = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Keyed pseudo-random bijection over [0, size): a balanced Feistel network on the next even power of two, with cycle
+// walking to stay inside the domain. Walking from index 0..size-1 visits every element exactly once in random order.
+class Permutation {
+public:
+    Permutation(uint64_t size, uint64_t seed) noexcept : mSize(size) {
+        const unsigned bits = std::max(2u, static_cast<unsigned>(std::bit_width(size > 0 ? size - 1 : 0)));
+        mHalfBits           = (bits + 1) / 2;
+        mHalfMask           = (uint64_t{1} << mHalfBits) - 1;
+        for (auto& key : mKeys) key = seed = splitMix64(seed);
+    }
+
+    [[nodiscard]] uint64_t size() const noexcept { return mSize; }
+
+    [[nodiscard]] uint64_t operator()(uint64_t index) const noexcept {
+        uint64_t value = index;
+        do {
+            value = encrypt(value);
+        } while (value >= mSize);
+        return value;
+    }
+
+private:
+    [[nodiscard]] uint64_t encrypt(uint64_t value) const noexcept {
+        uint64_t left  = value >> mHalfBits;
+        uint64_t right = value & mHalfMask;
+        for (const uint64_t key : mKeys) {
+            const uint64_t next = left ^ (splitMix64(right ^ key) & mHalfMask);
+            left                = right;
+            right               = next;
+        }
+        return (left << mHalfBits) | right;
+    }
+
+    uint64_t                mSize;
+    unsigned                mHalfBits = 1;
+    uint64_t                mHalfMask = 1;
+    std::array<uint64_t, 4> mKeys{};
+};
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -0,0 +1,301 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "PingEngine.hpp"
+#include <thread>
+
+namespace motdpe::detail {
+
+namespace {
+
+constexpr int SOCKET_BUFFER_SIZE = 4 * 1024 * 1024;
+
+} // namespace
+
+PingEngine::PingEngine(const TransportOptions& transport, const RateControllerOptions& rate)
+: mSelection(transport.selection) {
+    ensureSocketsInitialized();
+
+    if (transport.sources.empty()) {
+        addSource(PingSource{}, rate, false);
+        addSource(PingSource{}, rate, true);
+    } else {
+        for (const auto& source : transport.sources) addSource(source, rate, false);
+    }
+
+    for (const auto& source : mSources) {
+        mPollFds.push_back(PollFd{source.socket, POLL_READ_EVENT, 0});
+    }
+}
+
+void PingEngine::addSource(const PingSource& source, const RateControllerOptions& rate, bool wildcardIpv6) {
+    const bool wildcard = source.address.empty();
+    Endpoint   local;
+    if (wildcard) {
+        local.ipv6 = wildcardIpv6;
+    } else if (auto parsed = Endpoint::parse(source.address, 0)) {
+        local = *parsed;
+    } else {
+        throw MotdException{std::format("Invalid source address: {}", source.address)};
+    }
+
+    SocketHandle sock{socket(local.ipv6 ? AF_INET6 : AF_INET, SOCK_DGRAM, IPPROTO_UDP)};
+    if (!sock || !setNonBlocking(sock)) {
+        // A host without IPv6 simply has no wildcard IPv6 source.
+        if (wildcard) return;
+        throw MotdException{std::format("Failed to create socket for source {}", source.address)};
+    }
+    if (local.ipv6) {
+        const int v6Only = 1;
+        setsockopt(sock, IPPROTO_IPV6, IPV6_V6ONLY, reinterpret_cast<const char*>(&v6Only), sizeof(v6Only));
+    }
+    // Best effort: large scans keep many pongs queued between receive passes.
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&SOCKET_BUFFER_SIZE), sizeof(int));
+    setsockopt(sock, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&SOCKET_BUFFER_SIZE), sizeof(int));
+
+    if (!source.device.empty()) {
+#ifdef SO_BINDTODEVICE
+        if (setsockopt(
+                sock,
+                SOL_SOCKET,
+                SO_BINDTODEVICE,
+                source.device.c_str(),
+                static_cast<socklen_t>(source.device.size())
+            )
+            == SOCKET_ERROR_VALUE) {
+            throw MotdException{std::format("Failed to bind to device {}", source.device)};
+        }
+#else
+        throw MotdException{std::format("Binding to device {} is not supported on this platform", source.device)};
+#endif
+    }
+
+    if (!wildcard) {
+        sockaddr_storage addr{};
+        const socklen_t  addrLen = toSockaddr(local, addr);
+        if (bind(sock, reinterpret_cast<const sockaddr*>(&addr), addrLen) == SOCKET_ERROR_VALUE) {
+            throw MotdException{std::format("Failed to bind source address {}", source.address)};
+        }
+    }
+
+    mSourcesByFamily[local.ipv6 ? 1 : 0].push_back(mSources.size());
+    mSources.push_back(Source{
+        std::move(sock),
+        local.ipv6,
+        RateController{rate},
+        SourceStats{wildcard ? std::string{local.ipv6 ? "::" : "0.0.0.0"} : source.address}
+    });
+}
+
+PingEngine::SendResult PingEngine::send(const Endpoint& endpoint, uint64_t token, Clock::time_point deadline) {
+    if (mPending.contains(endpoint)) return SendResult::Duplicate;
+
+    const auto& candidates = mSourcesByFamily[endpoint.ipv6 ? 1 : 0];
+    if (candidates.empty()) return SendResult::Failed;
+
+    const auto now = Clock::now();
+    size_t     first;
+    size_t     tries;
+    if (mSelection == SourceSelection::TargetHash) {
+        first = EndpointHash{}(endpoint) % candidates.size();
+        tries = 1;
+    } else {
+        first = mNextSource[endpoint.ipv6 ? 1 : 0];
+        tries = candidates.size();
+    }
+
+    for (size_t attempt = 0; attempt < tries; ++attempt) {
+        const size_t slot   = (first + attempt) % candidates.size();
+        const size_t index  = candidates[slot];
+        auto&        source = mSources[index];
+        if (source.controller.acquire(now, 1) == 0) continue;
+
+        const uint64_t   sentAt = steadyMicros();
+        const SendResult result = transmit(source, endpoint, sentAt);
+        if (result != SendResult::Sent) return result;
+
+        if (mSelection == SourceSelection::RoundRobin) mNextSource[endpoint.ipv6 ? 1 : 0] = slot + 1;
+        mPending.emplace(endpoint, Pending{token, sentAt, sentAt, deadline, index});
+        mDeadlines.emplace(deadline, endpoint);
+        return SendResult::Sent;
+    }
+    return SendResult::RateLimited;
+}
+
+PingEngine::SendResult PingEngine::resend(const Endpoint& endpoint, uint64_t token) {
+    const auto it = mPending.find(endpoint);
+    if (it == mPending.end() || it->second.token != token) return SendResult::Failed;
+
+    // Same source as the first ping, since pongs are only accepted on the socket that sent it.
+    auto& source = mSources[it->second.source];
+    if (source.controller.acquire(Clock::now(), 1) == 0) return SendResult::RateLimited;
+
+    const uint64_t   sentAt = steadyMicros();
+    const SendResult result = transmit(source, endpoint, sentAt);
+    if (result == SendResult::Sent) it->second.sentAt = sentAt;
+    return result;
+}
+
+PingEngine::SendResult PingEngine::transmit(Source& source, const Endpoint& endpoint, uint64_t sentAt) {
+    sockaddr_storage addr{};
+    const socklen_t  addrLen = toSockaddr(endpoint, addr);
+    const auto       packet  = makePing(sentAt);
+
+    if (sendto(
+            source.socket,
+            reinterpret_cast<const char*>(packet.data()),
+            static_cast<int>(packet.size()),
+            0,
+            reinterpret_cast<const sockaddr*>(&addr),
+            addrLen
+        )
+        == SOCKET_ERROR_VALUE) {
+        if (lastErrorWouldBlock()) return SendResult::WouldBlock;
+        ++source.stats.sendErrors;
+        return SendResult::Failed;
+    }
+    ++source.stats.sent;
+    return SendResult::Sent;
+}
+
+PingEngine::Clock::time_point PingEngine::nextSendTime() const noexcept {
+    auto next = Clock::time_point::max();
+    for (const auto& source : mSources) next = std::min(next, source.controller.nextSendTime());
+    return next;
+}
+
+bool PingEngine::wait(Clock::time_point until) {
+    const auto now  = Clock::now();
+    const auto wait = until > now ? until - now : Clock::duration::zero();
+    if (mPollFds.empty()) {
+        std::this_thread::sleep_for(wait);
+        return false;
+    }
+    return pollSockets(mPollFds.data(), mPollFds.size(), wait) > 0;
+}
+
+std::optional<PingEngine::Pong> PingEngine::receive() {
+    // Rotate between the sockets so a flood on one source cannot starve the others.
+    for (size_t drained = 0; drained < mSources.size();) {
+        const size_t index = mNextReceive;
+        auto&        sock  = mSources[index].socket;
+
+        sockaddr_storage fromAddr{};
+        socklen_t        fromLen = sizeof(fromAddr);
+        const int        recvLen = recvfrom(
+            sock,
+            reinterpret_cast<char*>(mRecvBuf.data()),
+            static_cast<int>(mRecvBuf.size()),
+            0,
+            reinterpret_cast<sockaddr*>(&fromAddr),
+            &fromLen
+        );
+        if (recvLen == SOCKET_ERROR_VALUE) {
+#ifdef _WIN32
+            // ICMP port unreachable surfaces as WSAECONNRESET on the next receive; it carries no data.
+            if (WSAGetLastError() == WSAECONNRESET) continue;
+#endif
+            mNextReceive = (mNextReceive + 1) % mSources.size();
+            ++drained;
+            continue;
+        }
+        mNextReceive = (mNextReceive + 1) % mSources.size();
+
+        Endpoint from;
+        if (!isPong(mRecvBuf.data(), static_cast<size_t>(recvLen))
+            || !fromSockaddr(reinterpret_cast<const sockaddr*>(&fromAddr), from)) {
+            continue;
+        }
+        const auto it = mPending.find(from);
+        if (it == mPending.end() || it->second.source != index) continue;
+
+        const uint64_t now    = steadyMicros();
+        const uint64_t echoed = pongTimestamp(mRecvBuf.data());
+        // Any ping of a hedged probe may be the one answered; its echoed timestamp tells which.
+        const uint64_t sentAt = echoed >= it->second.firstSentAt && echoed <= now ? echoed : it->second.sentAt;
+        const uint64_t token  = it->second.token;
+        const auto     rtt    = std::chrono::microseconds{now - sentAt};
+        mPending.erase(it);
+
+        auto& source = mSources[index];
+        ++source.stats.responses;
+        source.controller.onResponse(rtt, Clock::now());
+
+        return Pong{
+            from,
+            token,
+            std::string_view{
+                reinterpret_cast<const char*>(mRecvBuf.data() + PONG_HEADER_SIZE),
+                static_cast<size_t>(recvLen) - PONG_HEADER_SIZE
+            },
+            rtt
+        };
+    }
+    return std::nullopt;
+}
+
+std::optional<PingEngine::Expired> PingEngine::expire(Clock::time_point now) {
+    dropStaleDeadlines();
+    if (mDeadlines.empty() || mDeadlines.top().first > now) return std::nullopt;
+
+    const Endpoint endpoint = mDeadlines.top().second;
+    mDeadlines.pop();
+    const auto it = mPending.find(endpoint);
+    Expired    expired{endpoint, it->second.token};
+
+    auto& source = mSources[it->second.source];
+    ++source.stats.timeouts;
+    source.controller.onTimeout(now);
+
+    mPending.erase(it);
+    return expired;
+}
+
+std::optional<PingEngine::Clock::time_point> PingEngine::nextDeadline() {
+    dropStaleDeadlines();
+    if (mDeadlines.empty()) return std::nullopt;
+    return mDeadlines.top().first;
+}
+
+std::vector<SocketType> PingEngine::sockets() const {
+    std::vector<SocketType> sockets;
+    sockets.reserve(mSources.size());
+    for (const auto& source : mSources) sockets.push_back(source.socket);
+    return sockets;
+}
+
+std::vector<SourceStats> PingEngine::sourceStats() const {
+    std::vector<SourceStats> stats;
+    stats.reserve(mSources.size());
+    for (const auto& source : mSources) {
+        stats.push_back(source.stats);
+        stats.back().rate = source.controller.rate();
+    }
+    return stats;
+}
+
+double PingEngine::rate() const noexcept {
+    double total = 0.0;
+    for (const auto& source : mSources) total += source.controller.rate();
+    return total;
+}
+
+void PingEngine::congest(Clock::time_point now) {
+    for (auto& source : mSources) source.controller.onCongestion(now);
+}
+
+void PingEngine::dropStaleDeadlines() {
+    // Entries whose ping was answered are removed lazily.
+    while (!mDeadlines.empty()) {
+        const auto& [deadline, endpoint] = mDeadlines.top();
+        const auto it                    = mPending.find(endpoint);
+        if (it != mPending.end() && it->second.deadline == deadline) break;
+        mDeadlines.pop();
+    }
+}
+
+} // namespace motdpe::detail
\ No newline at end of file
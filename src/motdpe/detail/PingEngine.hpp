@@ -0,0 +1,118 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "Socket.hpp"
+#include "motdpe/Endpoint.hpp"
+#include "motdpe/RateController.hpp"
+#include "motdpe/Transport.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace motdpe::detail {
+
+// Non-blocking unconnected-ping transport shared by the batch and scan modes. Many pings can be in flight at once;
+// pongs are matched to the pending ping by source endpoint. Every local source owns its socket, rate controller and
+// counters, so the aggregate send rate scales with the number of egress addresses.
+class PingEngine {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class SendResult { Sent, RateLimited, WouldBlock, Failed, Duplicate };
+
+    struct Pong {
+        Endpoint                  endpoint;
+        uint64_t                  token;
+        std::string_view          motd; // Valid until the next call to receive().
+        std::chrono::microseconds rtt;
+    };
+
+    struct Expired {
+        Endpoint endpoint;
+        uint64_t token;
+    };
+
+    // Throws if an explicit source cannot be bound.
+    PingEngine(const TransportOptions& transport, const RateControllerOptions& rate);
+
+    PingEngine(const PingEngine&)            = delete;
+    PingEngine& operator=(const PingEngine&) = delete;
+
+    SendResult send(const Endpoint& endpoint, uint64_t token, Clock::time_point deadline);
+    // Hedged retransmit: another ping to an endpoint still pending under `token`, from the same source and with the
+    // same deadline; a pong to either resolves it. Failed when the endpoint is no longer pending under that token.
+    SendResult resend(const Endpoint& endpoint, uint64_t token);
+
+    // Earliest time at which some source will accept another ping.
+    [[nodiscard]] Clock::time_point nextSendTime() const noexcept;
+
+    // Blocks until a socket is readable or `until` passes.
+    bool wait(Clock::time_point until);
+
+    // Returns the next pong matching a pending ping, or nothing once the sockets are drained.
+    std::optional<Pong> receive();
+
+    // Returns the next pending ping whose deadline is not after `now`.
+    std::optional<Expired> expire(Clock::time_point now);
+
+    // One non-blocking socket per source, for callers that poll them from their own event loop.
+    [[nodiscard]] std::vector<SocketType> sockets() const;
+
+    [[nodiscard]] size_t                           inFlight() const noexcept { return mPending.size(); }
+    [[nodiscard]] std::optional<Clock::time_point> nextDeadline();
+
+    [[nodiscard]] std::vector<SourceStats> sourceStats() const;
+    // Sum of the per-source rates.
+    [[nodiscard]] double rate() const noexcept;
+
+    // Passes an external congestion signal to every source's rate controller.
+    void congest(Clock::time_point now);
+
+private:
+    struct Source {
+        SocketHandle   socket;
+        bool           ipv6;
+        RateController controller;
+        SourceStats    stats;
+    };
+
+    struct Pending {
+        uint64_t token;
+        // Timestamps of the first and the latest ping; they differ once the ping was resent.
+        uint64_t          firstSentAt;
+        uint64_t          sentAt;
+        Clock::time_point deadline;
+        size_t            source;
+    };
+
+    using Deadline      = std::pair<Clock::time_point, Endpoint>;
+    using DeadlineQueue = std::priority_queue<Deadline, std::vector<Deadline>, std::greater<>>;
+
+    void       addSource(const PingSource& source, const RateControllerOptions& rate, bool wildcardIpv6);
+    SendResult transmit(Source& source, const Endpoint& endpoint, uint64_t sentAt);
+    void dropStaleDeadlines();
+
+    SourceSelection                                     mSelection;
+    std::vector<Source>                                 mSources;
+    std::array<std::vector<size_t>, 2>                  mSourcesByFamily;
+    std::array<size_t, 2>                               mNextSource{};
+    std::unordered_map<Endpoint, Pending, EndpointHash> mPending;
+    DeadlineQueue                                       mDeadlines;
+    std::array<std::byte, 2048>                         mRecvBuf;
+    std::vector<PollFd>                                 mPollFds;
+    size_t                                              mNextReceive = 0;
+};
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -0,0 +1,38 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+
+namespace motdpe::detail {
+
+constexpr size_t PONG_FIELD_COUNT    = 12;
+constexpr size_t PONG_REQUIRED_COUNT = 6;
+
+using PongFields = std::array<std::string_view, PONG_FIELD_COUNT>;
+
+// Splits a server id string into its semicolon-separated fields, viewing into `payload`; returns the field count.
+inline size_t splitPongFields(std::string_view payload, PongFields& fields) noexcept {
+    size_t count = 0;
+    while (count < fields.size() && !payload.empty()) {
+        const auto end  = payload.find(';');
+        fields[count++] = payload.substr(0, end);
+        payload         = end == std::string_view::npos ? std::string_view{} : payload.substr(end + 1);
+    }
+    return count;
+}
+
+template <typename T>
+void parseNumber(std::string_view text, T& value) noexcept {
+    T parsed{};
+    if (std::from_chars(text.data(), text.data() + text.size(), parsed).ec == std::errc{}) value = parsed;
+}
+
+} // namespace motdpe::detail
\ No newline at end of file
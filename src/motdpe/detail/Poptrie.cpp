@@ -0,0 +1,107 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "Poptrie.hpp"
+#include <array>
+
+namespace motdpe::detail {
+
+void Poptrie::insert(const PrefixKey& key, unsigned length, uint8_t value) {
+    if (mBinary.empty()) mBinary.emplace_back();
+
+    int32_t node = 0;
+    for (unsigned depth = 0; depth < length; ++depth) {
+        const int side = key.bit(depth) ? 1 : 0;
+        if (mBinary[node].child[side] < 0) {
+            mBinary[node].child[side] = static_cast<int32_t>(mBinary.size());
+            mBinary.emplace_back();
+        }
+        node = mBinary[node].child[side];
+    }
+    if (!mBinary[node].hasValue) ++mPrefixCount;
+    mBinary[node].value    = value;
+    mBinary[node].hasValue = true;
+}
+
+void Poptrie::clear() {
+    mBinary.clear();
+    mDirect.clear();
+    mNodes.clear();
+    mLeaves.clear();
+    mPrefixCount = 0;
+}
+
+int32_t Poptrie::descend(int32_t node, uint32_t path, unsigned count, uint8_t& inherited) const noexcept {
+    for (unsigned i = 0; i < count && node >= 0; ++i) {
+        node = mBinary[node].child[(path >> (count - 1 - i)) & 1];
+        if (node >= 0 && mBinary[node].hasValue) inherited = mBinary[node].value;
+    }
+    return node;
+}
+
+bool Poptrie::hasChildren(int32_t node) const noexcept {
+    return node >= 0 && (mBinary[node].child[0] >= 0 || mBinary[node].child[1] >= 0);
+}
+
+void Poptrie::build() {
+    mDirect.assign(size_t{1} << DIRECT_BITS, LEAF_FLAG);
+    mNodes.clear();
+    mLeaves.clear();
+    if (mBinary.empty()) return;
+
+    uint8_t rootValue = mBinary[0].hasValue ? mBinary[0].value : 0;
+    for (uint32_t prefix = 0; prefix < mDirect.size(); ++prefix) {
+        uint8_t       inherited = rootValue;
+        const int32_t node      = descend(0, prefix, DIRECT_BITS, inherited);
+        if (hasChildren(node)) {
+            const auto index = static_cast<uint32_t>(mNodes.size());
+            mNodes.emplace_back();
+            compileNode(index, node, inherited);
+            mDirect[prefix] = index;
+        } else {
+            mDirect[prefix] = LEAF_FLAG | inherited;
+        }
+    }
+}
+
+void Poptrie::compileNode(uint32_t index, int32_t binary, uint8_t inherited) {
+    constexpr uint32_t FANOUT = 1u << STRIDE;
+
+    std::array<int32_t, FANOUT> children{};
+    std::array<uint8_t, FANOUT> values{};
+    Node                        node;
+    size_t                      childCount = 0;
+    bool                        haveLeaf   = false;
+    uint8_t                     lastLeaf   = 0;
+
+    node.leafBase = static_cast<uint32_t>(mLeaves.size());
+    for (uint32_t chunk = 0; chunk < FANOUT; ++chunk) {
+        values[chunk]   = inherited;
+        children[chunk] = descend(binary, chunk, STRIDE, values[chunk]);
+        if (hasChildren(children[chunk])) {
+            node.vector |= uint64_t{1} << chunk;
+            ++childCount;
+        } else if (!haveLeaf || values[chunk] != lastLeaf) {
+            node.leafVector |= uint64_t{1} << chunk;
+            mLeaves.push_back(values[chunk]);
+            haveLeaf = true;
+            lastLeaf = values[chunk];
+        }
+    }
+
+    // Children of one node are contiguous, so reserve their slots before recursing.
+    node.childBase = static_cast<uint32_t>(mNodes.size());
+    mNodes.resize(mNodes.size() + childCount);
+    mNodes[index] = node;
+
+    uint32_t slot = node.childBase;
+    for (uint32_t chunk = 0; chunk < FANOUT; ++chunk) {
+        if (node.vector & (uint64_t{1} << chunk)) compileNode(slot++, children[chunk], values[chunk]);
+    }
+}
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -0,0 +1,101 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace motdpe::detail {
+
+// 128-bit lookup key, most significant bit first. IPv4 addresses occupy the top 32 bits of `hi`.
+struct PrefixKey {
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+
+    [[nodiscard]] constexpr bool bit(unsigned offset) const noexcept {
+        return offset < 64 ? (hi >> (63 - offset)) & 1 : (lo >> (127 - offset)) & 1;
+    }
+
+    // Bits [offset, offset + count) as an integer; bits past the end of the key read as zero.
+    [[nodiscard]] constexpr uint32_t bits(unsigned offset, unsigned count) const noexcept {
+        uint32_t value = 0;
+        for (unsigned i = 0; i < count; ++i) value = (value << 1) | (offset + i < 128 && bit(offset + i) ? 1u : 0u);
+        return value;
+    }
+
+    [[nodiscard]] uint32_t chunk6(unsigned offset) const noexcept {
+        if (offset <= 58) return static_cast<uint32_t>(hi >> (58 - offset)) & 0x3F;
+        if (offset >= 64 && offset <= 122) return static_cast<uint32_t>(lo >> (122 - offset)) & 0x3F;
+        return bits(offset, 6);
+    }
+};
+
+// Longest-prefix-match table after Asai & Ohara, "Poptrie" (SIGCOMM 2015): a 16-bit direct-pointing root followed by
+// 64-ary nodes whose children and leaves are located with popcount over per-node bitmaps, and leaf runs with equal
+// values compressed into one entry. Values are small integers; 0 means "no matching prefix".
+class Poptrie {
+public:
+    static constexpr unsigned DIRECT_BITS = 16;
+    static constexpr unsigned STRIDE      = 6;
+
+    void insert(const PrefixKey& key, unsigned length, uint8_t value);
+    void build();
+    void clear();
+
+    [[nodiscard]] size_t prefixCount() const noexcept { return mPrefixCount; }
+
+    [[nodiscard]] uint8_t lookup(const PrefixKey& key) const noexcept {
+        if (mDirect.empty()) return 0;
+        const uint32_t entry = mDirect[key.hi >> (64 - DIRECT_BITS)];
+        if (entry & LEAF_FLAG) return static_cast<uint8_t>(entry);
+
+        const Node* node   = &mNodes[entry];
+        unsigned    offset = DIRECT_BITS;
+        for (;;) {
+            const uint32_t chunk = key.chunk6(offset);
+            const uint64_t mask  = (uint64_t{2} << chunk) - 1; // Bits 0..chunk; all ones when chunk is 63.
+            if (node->vector & (uint64_t{1} << chunk)) {
+                node    = &mNodes[node->childBase + std::popcount(node->vector & mask) - 1];
+                offset += STRIDE;
+            } else {
+                return mLeaves[node->leafBase + std::popcount(node->leafVector & mask) - 1];
+            }
+        }
+    }
+
+private:
+    static constexpr uint32_t LEAF_FLAG = 0x80000000u;
+
+    struct Node {
+        uint64_t vector     = 0; // Bit i set: chunk value i descends into a child node.
+        uint64_t leafVector = 0; // Bit i set: a new leaf run starts at chunk value i.
+        uint32_t leafBase   = 0;
+        uint32_t childBase  = 0;
+    };
+
+    // Uncompressed binary trie used to stage prefixes until build().
+    struct BinaryNode {
+        int32_t child[2] = {-1, -1};
+        uint8_t value    = 0;
+        bool    hasValue = false;
+    };
+
+    // Follows `count` bits of `path` from `node`, updating `inherited` with every prefix passed on the way.
+    int32_t descend(int32_t node, uint32_t path, unsigned count, uint8_t& inherited) const noexcept;
+    bool    hasChildren(int32_t node) const noexcept;
+    void    compileNode(uint32_t index, int32_t binary, uint8_t inherited);
+
+    std::vector<BinaryNode> mBinary;
+    std::vector<uint32_t>   mDirect;
+    std::vector<Node>       mNodes;
+    std::vector<uint8_t>    mLeaves;
+    size_t                  mPrefixCount = 0;
+};
+
+} // namespace motdpe::detail
\ No newline at end of file
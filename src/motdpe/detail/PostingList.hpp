@@ -0,0 +1,110 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace motdpe::detail {
+
+// Sorted set of row numbers stored as varint-encoded gaps, typically one or two bytes per row. Recent insertions and
+// removals are kept in small sorted side lists and folded into the packed form once they grow past an eighth of it,
+// so updates stay cheap without re-encoding the list every time.
+class PostingList {
+public:
+    void insert(uint32_t row) {
+        // A row removed since the last compaction is still packed; cancelling the removal restores it.
+        if (eraseSorted(mRemoved, row)) return;
+        insertSorted(mAdded, row);
+        compactIfNeeded();
+    }
+
+    void erase(uint32_t row) {
+        if (eraseSorted(mAdded, row)) return;
+        insertSorted(mRemoved, row);
+        compactIfNeeded();
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return mPackedCount + mAdded.size() - mRemoved.size(); }
+    [[nodiscard]] bool   empty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] size_t memoryBytes() const noexcept {
+        return mPacked.capacity() + (mAdded.capacity() + mRemoved.capacity()) * sizeof(uint32_t);
+    }
+
+    // Replaces `out` with the rows in ascending order.
+    void decode(std::vector<uint32_t>& out) const {
+        out.clear();
+        out.reserve(size());
+        auto     added   = mAdded.begin();
+        auto     removed = mRemoved.begin();
+        uint32_t row     = 0;
+        for (size_t pos = 0; pos < mPacked.size();) {
+            uint32_t gap   = 0;
+            int      shift = 0;
+            uint8_t  byte;
+            do {
+                byte   = mPacked[pos++];
+                gap   |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+            row += gap;
+            while (added != mAdded.end() && *added < row) out.push_back(*added++);
+            if (removed != mRemoved.end() && *removed == row) {
+                ++removed;
+                continue;
+            }
+            out.push_back(row);
+        }
+        out.insert(out.end(), added, mAdded.end());
+    }
+
+private:
+    static void insertSorted(std::vector<uint32_t>& rows, uint32_t row) {
+        const auto it = std::lower_bound(rows.begin(), rows.end(), row);
+        if (it == rows.end() || *it != row) rows.insert(it, row);
+    }
+
+    static bool eraseSorted(std::vector<uint32_t>& rows, uint32_t row) {
+        const auto it = std::lower_bound(rows.begin(), rows.end(), row);
+        if (it == rows.end() || *it != row) return false;
+        rows.erase(it);
+        return true;
+    }
+
+    void compactIfNeeded() {
+        if (mAdded.size() + mRemoved.size() <= std::max<size_t>(16, mPackedCount / 8)) return;
+        std::vector<uint32_t> rows;
+        decode(rows);
+        mPacked.clear();
+        uint32_t previous = 0;
+        for (const uint32_t row : rows) {
+            for (uint32_t gap = row - previous; ; gap >>= 7) {
+                if (gap < 0x80) {
+                    mPacked.push_back(static_cast<uint8_t>(gap));
+                    break;
+                }
+                mPacked.push_back(static_cast<uint8_t>(gap | 0x80));
+            }
+            previous = row;
+        }
+        mPacked.shrink_to_fit();
+        mPackedCount = rows.size();
+        mAdded.clear();
+        mRemoved.clear();
+    }
+
+    std::vector<uint8_t>  mPacked;
+    size_t                mPackedCount = 0;
+    std::vector<uint32_t> mAdded;
+    std::vector<uint32_t> mRemoved;
+};
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -0,0 +1,35 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Endpoint.hpp"
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace motdpe::detail {
+
+struct PingReply {
+    std::string               motd;
+    std::chrono::microseconds rtt;
+};
+
+// Blocking single-target queries; throw MotdTimeoutException when no pong arrives and MotdException otherwise.
+PingReply QueryMotdImpl(
+    std::string_view          host,
+    uint16_t                  port,
+    std::chrono::milliseconds timeout,
+    std::chrono::milliseconds hedgeDelay
+);
+
+PingReply QueryEndpointImpl(
+    const Endpoint&           endpoint,
+    std::chrono::milliseconds timeout,
+    std::chrono::milliseconds hedgeDelay
+);
+
+} // namespace motdpe::detail
\ No newline at end of file
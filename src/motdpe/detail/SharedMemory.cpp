@@ -0,0 +1,183 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "SharedMemory.hpp"
+#include "Socket.hpp"
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace motdpe::detail {
+
+namespace {
+
+#ifdef _WIN32
+std::string regionName(std::string_view name) { return std::format("Local\\{}", name); }
+#else
+// POSIX shared-memory names are a single path component with a leading slash.
+std::string regionName(std::string_view name) {
+    return name.starts_with('/') ? std::string{name} : std::format("/{}", name);
+}
+#endif
+
+} // namespace
+
+#ifdef _WIN32
+
+SharedMemory SharedMemory::create(std::string_view name, size_t size, const StalePredicate&) {
+    SharedMemory region;
+    region.mName    = regionName(name);
+    const auto high = static_cast<DWORD>(static_cast<uint64_t>(size) >> 32);
+    const auto low  = static_cast<DWORD>(size);
+    const auto mapping =
+        CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, high, low, region.mName.c_str());
+    if (!mapping) throw MotdException{std::format("Failed to create shared memory {}: {}", name, GetLastError())};
+    region.mHandle = mapping;
+    // The existing mapping was returned; clearing it would pull the data out from under its readers.
+    if (GetLastError() == ERROR_ALREADY_EXISTS) throw MotdException{std::format("Shared memory {} is in use", name)};
+    region.mData   = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!region.mData) throw MotdException{std::format("Failed to map shared memory {}: {}", name, GetLastError())};
+    region.mSize = size;
+    std::memset(region.mData, 0, size);
+    return region;
+}
+
+SharedMemory SharedMemory::openReadOnly(std::string_view name) {
+    SharedMemory region;
+    region.mName       = regionName(name);
+    const auto mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, region.mName.c_str());
+    if (!mapping) throw MotdException{std::format("Failed to open shared memory {}: {}", name, GetLastError())};
+    region.mHandle = mapping;
+    region.mData   = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!region.mData) throw MotdException{std::format("Failed to map shared memory {}: {}", name, GetLastError())};
+
+    MEMORY_BASIC_INFORMATION info{};
+    VirtualQuery(region.mData, &info, sizeof(info));
+    region.mSize = info.RegionSize;
+    return region;
+}
+
+uint32_t SharedMemory::currentProcessId() noexcept { return static_cast<uint32_t>(GetCurrentProcessId()); }
+
+bool SharedMemory::processAlive(uint32_t processId) noexcept {
+    const HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, processId);
+    if (!process) return GetLastError() != ERROR_INVALID_PARAMETER;
+    const bool alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return alive;
+}
+
+void SharedMemory::release() noexcept {
+    if (mData) UnmapViewOfFile(mData);
+    if (mHandle) CloseHandle(mHandle);
+    mData   = nullptr;
+    mHandle = nullptr;
+}
+
+#else
+
+SharedMemory SharedMemory::create(std::string_view name, size_t size, const StalePredicate& stale) {
+    SharedMemory region;
+    region.mName = regionName(name);
+    int fd       = shm_open(region.mName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0 && errno == EEXIST) {
+        // A region left behind by a crashed publisher is replaced rather than reused with an unknown layout; one
+        // whose publisher is still running is left alone.
+        bool replace = false;
+        try {
+            const SharedMemory existing = openReadOnly(name);
+            replace                     = stale(existing.data(), existing.size());
+        } catch (const MotdException&) {
+            // Empty or vanished in the meantime: nothing is being served from it.
+            replace = true;
+        }
+        if (!replace) throw MotdException{std::format("Shared memory {} is in use", name)};
+        shm_unlink(region.mName.c_str());
+        fd = shm_open(region.mName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    }
+    if (fd < 0) throw MotdException{std::format("Failed to create shared memory {}: {}", name, std::strerror(errno))};
+    region.mOwner = true;
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        const int error = errno;
+        close(fd);
+        throw MotdException{std::format("Failed to size shared memory {}: {}", name, std::strerror(error))};
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw MotdException{std::format("Failed to map shared memory {}: {}", name, std::strerror(errno))};
+    }
+    region.mData = data;
+    region.mSize = size;
+    return region;
+}
+
+SharedMemory SharedMemory::openReadOnly(std::string_view name) {
+    SharedMemory region;
+    region.mName = regionName(name);
+    const int fd = shm_open(region.mName.c_str(), O_RDONLY, 0);
+    if (fd < 0) throw MotdException{std::format("Failed to open shared memory {}: {}", name, std::strerror(errno))};
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        throw MotdException{std::format("Shared memory {} is empty", name)};
+    }
+    void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw MotdException{std::format("Failed to map shared memory {}: {}", name, std::strerror(errno))};
+    }
+    region.mData = data;
+    region.mSize = static_cast<size_t>(info.st_size);
+    return region;
+}
+
+uint32_t SharedMemory::currentProcessId() noexcept { return static_cast<uint32_t>(getpid()); }
+
+bool SharedMemory::processAlive(uint32_t processId) noexcept {
+    return processId != 0 && (kill(static_cast<pid_t>(processId), 0) == 0 || errno == EPERM);
+}
+
+void SharedMemory::release() noexcept {
+    if (mData) munmap(mData, mSize);
+    if (mOwner) shm_unlink(mName.c_str());
+    mData  = nullptr;
+    mOwner = false;
+}
+
+#endif
+
+SharedMemory::~SharedMemory() { release(); }
+
+SharedMemory::SharedMemory(SharedMemory&& other) noexcept
+: mName(std::move(other.mName)),
+  mData(std::exchange(other.mData, nullptr)),
+  mSize(std::exchange(other.mSize, 0)),
+  mHandle(std::exchange(other.mHandle, nullptr)),
+  mOwner(std::exchange(other.mOwner, false)) {}
+
+SharedMemory& SharedMemory::operator=(SharedMemory&& other) noexcept {
+    if (this != &other) {
+        release();
+        mName   = std::move(other.mName);
+        mData   = std::exchange(other.mData, nullptr);
+        mSize   = std::exchange(other.mSize, 0);
+        mHandle = std::exchange(other.mHandle, nullptr);
+        mOwner  = std::exchange(other.mOwner, false);
+    }
+    return *this;
+}
+
+} // namespace motdpe::detail
\ No newline at end of file
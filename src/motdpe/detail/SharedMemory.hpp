@@ -0,0 +1,59 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace motdpe::detail {
+
+// Mapping of a named shared-memory region (POSIX shm_open, or a named file mapping on Windows). The creator owns the
+// name and removes it on destruction; processes that already mapped the region keep their view.
+class SharedMemory {
+public:
+    // Decides from the contents of an existing region of the same name whether its creator is gone.
+    using StalePredicate = std::function<bool(const void* data, size_t size)>;
+
+    // Creates a zero-filled region; throws on failure. A region of the same name is replaced only where `stale`
+    // says so, otherwise creation fails rather than cutting that region's readers off. On Windows a name stays taken
+    // while anyone has it mapped, so an existing region always fails.
+    static SharedMemory create(std::string_view name, size_t size, const StalePredicate& stale);
+    // Maps an existing region read-only; throws if it does not exist.
+    static SharedMemory openReadOnly(std::string_view name);
+
+    ~SharedMemory();
+
+    SharedMemory(SharedMemory&& other) noexcept;
+    SharedMemory& operator=(SharedMemory&& other) noexcept;
+
+    SharedMemory(const SharedMemory&)            = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    [[nodiscard]] void*       data() noexcept { return mData; }
+    [[nodiscard]] const void* data() const noexcept { return mData; }
+    [[nodiscard]] size_t      size() const noexcept { return mSize; }
+
+    [[nodiscard]] static uint32_t currentProcessId() noexcept;
+    // False only when the process is known to be gone; may be true for a reused id.
+    [[nodiscard]] static bool processAlive(uint32_t processId) noexcept;
+
+private:
+    SharedMemory() = default;
+
+    void release() noexcept;
+
+    std::string mName;
+    void*       mData   = nullptr;
+    size_t      mSize   = 0;
+    void*       mHandle = nullptr;
+    bool        mOwner  = false;
+};
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -0,0 +1,357 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/Endpoint.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN32
+#include <WS2tcpip.h>
+#include <winsock2.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace motdpe::detail {
+
+constexpr std::byte operator""_b(unsigned long long value) noexcept { return static_cast<std::byte>(value); }
+
+class MotdException : public std::runtime_error {
+public:
+    using runtime_error::runtime_error;
+};
+
+#ifdef _WIN32
+using SocketType                          = SOCKET;
+constexpr SocketType INVALID_SOCKET_VALUE = INVALID_SOCKET;
+constexpr int        SOCKET_ERROR_VALUE   = SOCKET_ERROR;
+#else
+using SocketType                          = int;
+constexpr SocketType INVALID_SOCKET_VALUE = -1;
+constexpr int        SOCKET_ERROR_VALUE   = -1;
+#endif
+
+#ifdef _WIN32
+class SocketInitializer {
+public:
+    SocketInitializer() {
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+            throw MotdException{std::format("WSAStartup failed: {}", WSAGetLastError())};
+        }
+    }
+
+    ~SocketInitializer() noexcept { WSACleanup(); }
+
+    SocketInitializer(const SocketInitializer&)            = delete;
+    SocketInitializer& operator=(const SocketInitializer&) = delete;
+};
+#endif
+
+class SocketHandle {
+public:
+    explicit SocketHandle(SocketType sock) noexcept : mSocket(sock) {}
+
+    ~SocketHandle() noexcept { close(); }
+
+    SocketHandle(const SocketHandle&)            = delete;
+    SocketHandle& operator=(const SocketHandle&) = delete;
+
+    SocketHandle(SocketHandle&& other) noexcept : mSocket(std::exchange(other.mSocket, INVALID_SOCKET_VALUE)) {}
+
+    SocketHandle& operator=(SocketHandle&& other) noexcept {
+        if (this != &other) {
+            close();
+            mSocket = std::exchange(other.mSocket, INVALID_SOCKET_VALUE);
+        }
+        return *this;
+    }
+
+    operator SocketType() const noexcept { return mSocket; }
+    explicit operator bool() const noexcept { return mSocket != INVALID_SOCKET_VALUE; }
+
+    void close() noexcept {
+        if (mSocket != INVALID_SOCKET_VALUE) {
+#ifdef _WIN32
+            closesocket(mSocket);
+#else
+            ::close(mSocket);
+#endif
+            mSocket = INVALID_SOCKET_VALUE;
+        }
+    }
+
+private:
+    SocketType mSocket = INVALID_SOCKET_VALUE;
+};
+
+class AddrInfoPtr {
+public:
+    explicit AddrInfoPtr(addrinfo* ai) : mAddrInfo(ai) {}
+    ~AddrInfoPtr() {
+        if (mAddrInfo) freeaddrinfo(mAddrInfo);
+    }
+
+    AddrInfoPtr(const AddrInfoPtr&)            = delete;
+    AddrInfoPtr& operator=(const AddrInfoPtr&) = delete;
+
+    AddrInfoPtr(AddrInfoPtr&& other) noexcept : mAddrInfo(std::exchange(other.mAddrInfo, nullptr)) {}
+
+    AddrInfoPtr& operator=(AddrInfoPtr&& other) noexcept {
+        if (this != &other) {
+            reset();
+            mAddrInfo = std::exchange(other.mAddrInfo, nullptr);
+        }
+        return *this;
+    }
+
+    void reset() noexcept {
+        if (mAddrInfo) {
+            freeaddrinfo(mAddrInfo);
+            mAddrInfo = nullptr;
+        }
+    }
+
+    addrinfo* get() const noexcept { return mAddrInfo; }
+    addrinfo* operator->() const noexcept { return mAddrInfo; }
+    explicit  operator bool() const noexcept { return mAddrInfo != nullptr; }
+
+private:
+    addrinfo* mAddrInfo = nullptr;
+};
+
+class MotdTimeoutException : public MotdException {
+public:
+    using MotdException::MotdException;
+};
+
+inline uint64_t steadyMicros() noexcept {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count()
+    );
+}
+
+inline bool waitReadable(SocketType sock, std::chrono::steady_clock::duration wait) noexcept {
+    const auto waitMs = std::max<int64_t>(std::chrono::ceil<std::chrono::milliseconds>(wait).count(), 0);
+#ifdef _WIN32
+    WSAPOLLFD pfd{sock, POLLRDNORM, 0};
+    return WSAPoll(&pfd, 1, static_cast<INT>(waitMs)) > 0;
+#else
+    pollfd pfd{sock, POLLIN, 0};
+    return ::poll(&pfd, 1, static_cast<int>(waitMs)) > 0;
+#endif
+}
+
+#ifdef _WIN32
+using PollFd                     = WSAPOLLFD;
+constexpr short POLL_READ_EVENT  = POLLRDNORM;
+constexpr short POLL_WRITE_EVENT = POLLWRNORM;
+#else
+using PollFd                     = pollfd;
+constexpr short POLL_READ_EVENT  = POLLIN;
+constexpr short POLL_WRITE_EVENT = POLLOUT;
+#endif
+
+inline int pollSockets(PollFd* fds, size_t count, std::chrono::steady_clock::duration wait) noexcept {
+    const auto waitMs = std::max<int64_t>(std::chrono::ceil<std::chrono::milliseconds>(wait).count(), 0);
+#ifdef _WIN32
+    return WSAPoll(fds, static_cast<ULONG>(count), static_cast<INT>(waitMs));
+#else
+    return ::poll(fds, static_cast<nfds_t>(count), static_cast<int>(waitMs));
+#endif
+}
+
+inline void ensureSocketsInitialized() {
+#ifdef _WIN32
+    [[maybe_unused]] static const SocketInitializer initializer;
+#endif
+}
+
+inline std::string addrInfoError(int status) {
+#ifdef _WIN32
+    const wchar_t* errorMsg = gai_strerror(status);
+    int            size     = WideCharToMultiByte(CP_UTF8, 0, errorMsg, -1, nullptr, 0, nullptr, nullptr);
+    std::string    utf8Msg(size, 0);
+    WideCharToMultiByte(CP_UTF8, 0, errorMsg, -1, &utf8Msg[0], size, nullptr, nullptr);
+    if (!utf8Msg.empty() && utf8Msg.back() == '\0') utf8Msg.pop_back();
+    return utf8Msg;
+#else
+    return gai_strerror(status);
+#endif
+}
+
+inline bool setNonBlocking(SocketType sock) noexcept {
+#ifdef _WIN32
+    u_long mode = 1;
+    return ioctlsocket(sock, FIONBIO, &mode) == 0;
+#else
+    const int flags = fcntl(sock, F_GETFL, 0);
+    return flags != -1 && fcntl(sock, F_SETFL, flags | O_NONBLOCK) != -1;
+#endif
+}
+
+inline bool lastErrorWouldBlock() noexcept {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+// Keeps writes to a stream socket whose peer has gone from raising SIGPIPE where MSG_NOSIGNAL is missing (macOS, BSD).
+inline void suppressSigPipe([[maybe_unused]] SocketType sock) noexcept {
+#ifdef SO_NOSIGPIPE
+    const int enable = 1;
+    setsockopt(sock, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+}
+
+// Gathers up to four `parts` into one send; returns the number of bytes sent or -1. Never raises SIGPIPE on sockets
+// passed through suppressSigPipe().
+inline int64_t sendParts(SocketType sock, std::span<const std::string_view> parts) noexcept {
+#ifdef _WIN32
+    std::array<WSABUF, 4> buffers{};
+    DWORD                 count = 0;
+    for (const std::string_view part : parts.first(std::min<size_t>(parts.size(), buffers.size()))) {
+        if (!part.empty()) buffers[count++] = WSABUF{static_cast<ULONG>(part.size()), const_cast<char*>(part.data())};
+    }
+    DWORD sent = 0;
+    if (WSASend(sock, buffers.data(), count, &sent, 0, nullptr, nullptr) != 0) return -1;
+    return sent;
+#else
+    std::array<iovec, 4> buffers{};
+    size_t               count = 0;
+    for (const std::string_view part : parts.first(std::min<size_t>(parts.size(), buffers.size()))) {
+        if (!part.empty()) buffers[count++] = iovec{const_cast<char*>(part.data()), part.size()};
+    }
+    msghdr message{};
+    message.msg_iov    = buffers.data();
+    message.msg_iovlen = count;
+#ifdef MSG_NOSIGNAL
+    return sendmsg(sock, &message, MSG_NOSIGNAL);
+#else
+    return sendmsg(sock, &message, 0);
+#endif
+#endif
+}
+
+// Loopback datagram socket that other threads poke to interrupt the owning thread's poll().
+class WakeSocket {
+public:
+    explicit WakeSocket(std::string_view owner) {
+        ensureSocketsInitialized();
+        mSocket = SocketHandle{socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)};
+
+        mAddr.sin_family      = AF_INET;
+        mAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addrLen     = sizeof(mAddr);
+        if (!mSocket || !setNonBlocking(mSocket)
+            || bind(mSocket, reinterpret_cast<const sockaddr*>(&mAddr), addrLen) == SOCKET_ERROR_VALUE
+            || getsockname(mSocket, reinterpret_cast<sockaddr*>(&mAddr), &addrLen) == SOCKET_ERROR_VALUE) {
+            throw MotdException{std::format("Failed to create the {}'s wake-up socket", owner)};
+        }
+    }
+
+    [[nodiscard]] SocketType handle() const noexcept { return mSocket; }
+
+    void wake() const noexcept {
+        const char byte = 0;
+        sendto(mSocket, &byte, 1, 0, reinterpret_cast<const sockaddr*>(&mAddr), sizeof(mAddr));
+    }
+
+    // Discards queued wake-ups once poll() reported the socket readable.
+    void drain() const noexcept {
+        char buffer[64];
+        while (recv(mSocket, buffer, sizeof(buffer), 0) > 0) {}
+    }
+
+private:
+    SocketHandle mSocket{INVALID_SOCKET_VALUE};
+    sockaddr_in  mAddr{};
+};
+
+// Unconnected ping template; bytes 1..8 carry the client timestamp that the server echoes back in its pong.
+inline constexpr std::array<std::byte, 33> PING_TEMPLATE = {
+    0x01_b, 0x00_b, 0x00_b, 0x00_b, 0x00_b, 0xFF_b, 0xFF_b, 0xC1_b, 0x1D_b, 0x00_b, 0xFF_b,
+    0xFF_b, 0x00_b, 0xFE_b, 0xFE_b, 0xFE_b, 0xFE_b, 0xFD_b, 0xFD_b, 0xFD_b, 0xFD_b, 0x12_b,
+    0x34_b, 0x56_b, 0x78_b, 0x9C_b, 0x18_b, 0x28_b, 0x7F_b, 0xE1_b, 0x64_b, 0x89_b, 0x8D_b
+};
+
+// Packet id + timestamp + server GUID + offline magic + string length.
+inline constexpr size_t PONG_HEADER_SIZE = 35;
+
+inline std::array<std::byte, 33> makePing(uint64_t timestamp) noexcept {
+    auto packet = PING_TEMPLATE;
+    for (size_t i = 0; i < 8; ++i) packet[1 + i] = static_cast<std::byte>(timestamp >> (56 - 8 * i));
+    return packet;
+}
+
+inline bool isPong(const std::byte* data, size_t size) noexcept {
+    return size > PONG_HEADER_SIZE && data[0] == 0x1C_b;
+}
+
+inline uint64_t pongTimestamp(const std::byte* data) noexcept {
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; ++i) value = (value << 8) | static_cast<uint64_t>(data[1 + i]);
+    return value;
+}
+
+inline socklen_t toSockaddr(const Endpoint& endpoint, sockaddr_storage& storage) noexcept {
+    storage = {};
+    if (endpoint.ipv6) {
+        auto& addr      = reinterpret_cast<sockaddr_in6&>(storage);
+        addr.sin6_family = AF_INET6;
+        addr.sin6_port   = htons(endpoint.port);
+        std::memcpy(&addr.sin6_addr, endpoint.address.data(), 16);
+        return sizeof(sockaddr_in6);
+    }
+    auto& addr      = reinterpret_cast<sockaddr_in&>(storage);
+    addr.sin_family = AF_INET;
+    addr.sin_port   = htons(endpoint.port);
+    std::memcpy(&addr.sin_addr, endpoint.address.data(), 4);
+    return sizeof(sockaddr_in);
+}
+
+inline bool fromSockaddr(const sockaddr* addr, Endpoint& endpoint) noexcept {
+    endpoint = {};
+    if (addr->sa_family == AF_INET6) {
+        const auto& in6 = *reinterpret_cast<const sockaddr_in6*>(addr);
+        endpoint.ipv6   = true;
+        endpoint.port   = ntohs(in6.sin6_port);
+        std::memcpy(endpoint.address.data(), &in6.sin6_addr, 16);
+        return true;
+    }
+    if (addr->sa_family == AF_INET) {
+        const auto& in4 = *reinterpret_cast<const sockaddr_in*>(addr);
+        endpoint.port   = ntohs(in4.sin_port);
+        std::memcpy(endpoint.address.data(), &in4.sin_addr, 4);
+        return true;
+    }
+    return false;
+}
+
+} // namespace motdpe::detail
\ No newline at end of file
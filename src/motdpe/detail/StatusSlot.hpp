@@ -0,0 +1,128 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include "motdpe/StatusTable.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <thread>
+
+namespace motdpe::detail {
+
+// Layout shared by in-process status tables and shared-memory regions: a 64-byte header followed by a power-of-two
+// number of 64-byte-aligned slots, each a key, a sequence counter and the record as 64-bit words. Readers in other
+// processes depend on it, so any change must bump STATUS_VERSION.
+
+constexpr std::array<char, 8> STATUS_MAGIC{'M', 'O', 'T', 'D', 'P', 'E', 'S', 'T'};
+constexpr uint32_t            STATUS_VERSION    = 1;
+constexpr uint32_t            STATUS_BYTE_ORDER = 0x01020304;
+
+// Key of a slot that never held a target; probing stops there.
+constexpr uint64_t STATUS_EMPTY = 0;
+// Key of a slot whose target was erased; probing continues past it and the writer may reuse it.
+constexpr uint64_t STATUS_ERASED = UINT64_MAX;
+
+constexpr size_t STATUS_WORDS = sizeof(StatusRecord) / sizeof(uint64_t);
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared status slots need address-free 64-bit atomics");
+
+struct alignas(64) StatusSlot {
+    std::atomic<uint64_t>                           key{STATUS_EMPTY};
+    std::atomic<uint64_t>                           sequence{0};
+    std::array<std::atomic<uint64_t>, STATUS_WORDS> words{};
+};
+
+struct alignas(64) StatusHeader {
+    std::array<char, 8> magic;
+    // Written last by the creator; readers treat any other value as an incompatible or unfinished region.
+    std::atomic<uint32_t> version;
+    uint32_t              byteOrder;
+    uint32_t              recordSize;
+    uint32_t              slotSize;
+    uint64_t              slotCount;
+    std::atomic<uint64_t> size;
+    // Set when the publisher goes away; readers should reopen the region by name.
+    std::atomic<uint32_t> closed;
+    // Process id of the publisher, so a new one can tell a region left by a crash from one still in use.
+    uint32_t owner;
+};
+
+static_assert(sizeof(StatusHeader) == 64 && sizeof(StatusSlot) % 64 == 0);
+
+// Slots for `capacity` targets at a load factor of at most 2/3.
+inline size_t statusSlots(size_t capacity) noexcept {
+    return std::bit_ceil(std::max<size_t>(capacity + capacity / 2, 16));
+}
+
+inline size_t statusHome(uint64_t id, size_t mask) noexcept {
+    return static_cast<size_t>((id * 0x9e3779b97f4a7c15ull) >> 32) & mask;
+}
+
+// Slot index of `id`, or mask + 1 if absent.
+inline size_t statusIndexOf(const StatusSlot* slots, size_t mask, uint64_t id) noexcept {
+    if (id == STATUS_EMPTY || id == STATUS_ERASED) return mask + 1;
+    for (size_t i = 0, index = statusHome(id, mask); i <= mask; ++i, index = (index + 1) & mask) {
+        const uint64_t key = slots[index].key.load(std::memory_order_acquire);
+        if (key == id) return index;
+        if (key == STATUS_EMPTY) break;
+    }
+    return mask + 1;
+}
+
+// Attempts before a reader gives up on a slot. Updates take nanoseconds, so only a writer that died halfway through
+// one, which leaves the sequence odd for good, gets anywhere near this.
+constexpr uint32_t STATUS_LOAD_ATTEMPTS = 1 << 16;
+
+// Reader half of the sequence lock: the copy is used only if the sequence was even and unchanged around it. Words
+// are relaxed atomics, so a torn copy is discarded rather than being a data race. The writer may be another process,
+// so the reader never waits for it indefinitely.
+inline std::optional<StatusRecord> statusLoad(const StatusSlot& slot) noexcept {
+    std::array<uint64_t, STATUS_WORDS> words;
+    for (uint32_t spins = 0; spins < STATUS_LOAD_ATTEMPTS; ++spins) {
+        const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+            for (size_t i = 0; i < STATUS_WORDS; ++i) words[i] = slot.words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == before) return std::bit_cast<StatusRecord>(words);
+        }
+        if (spins >= 64) std::this_thread::yield();
+    }
+    return std::nullopt;
+}
+
+// Writer half: odd sequence while the words change. Only one thread writes, so plain loads and stores suffice.
+inline void statusStore(StatusSlot& slot, const StatusRecord& record) noexcept {
+    const auto     words    = std::bit_cast<std::array<uint64_t, STATUS_WORDS>>(record);
+    const uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < STATUS_WORDS; ++i) slot.words[i].store(words[i], std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+inline std::optional<StatusRecord> statusRead(const StatusSlot* slots, size_t mask, uint64_t id) noexcept {
+    const size_t index = statusIndexOf(slots, mask, id);
+    if (index > mask) return std::nullopt;
+    // The slot may have been erased and reused since the key matched; the record carries its own id.
+    auto record = statusLoad(slots[index]);
+    if (!record || record->id != id) return std::nullopt;
+    return record;
+}
+
+inline std::optional<StatusRecord> statusReadSlot(const StatusSlot& slot) noexcept {
+    const uint64_t key = slot.key.load(std::memory_order_acquire);
+    if (key == STATUS_EMPTY || key == STATUS_ERASED) return std::nullopt;
+    auto record = statusLoad(slot);
+    if (!record || record->id != key) return std::nullopt;
+    return record;
+}
+
+} // namespace motdpe::detail
\ No newline at end of file
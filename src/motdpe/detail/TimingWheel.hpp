@@ -0,0 +1,92 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace motdpe::detail {
+
+// Hashed timing wheel (Varghese & Lauck): timers hash into one of a power-of-two number of slots by their deadline
+// tick and carry the number of remaining revolutions, so scheduling is O(1) and advancing costs one slot per elapsed
+// tick regardless of how many timers are pending. Timers fire at most one tick late and are never cancelled
+// explicitly; owners validate a fired value (for example with a generation number) instead.
+template <typename T>
+class TimingWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TimingWheel(Clock::duration tick, size_t slots, Clock::time_point start = Clock::now())
+    : mTick(std::max(tick, Clock::duration{1})),
+      mSlots(std::bit_ceil(std::max<size_t>(slots, 2))),
+      mMask(mSlots.size() - 1),
+      mStart(start) {}
+
+    void schedule(Clock::time_point at, T value) {
+        // Round up so that a timer never fires before its deadline.
+        const uint64_t tick   = std::max(ticksAt(at + mTick - Clock::duration{1}), mCurrent + 1);
+        const uint64_t rounds = (tick - mCurrent - 1) / mSlots.size();
+        mSlots[tick & mMask].push_back(Entry{rounds, std::move(value)});
+        ++mSize;
+    }
+
+    // Calls `fire(T&&)` for every timer due at `now`, in tick order.
+    template <typename Fire>
+    void advance(Clock::time_point now, Fire&& fire) {
+        const uint64_t target = ticksAt(now);
+        while (mCurrent < target) {
+            // With nothing pending, whole revolutions can be skipped.
+            if (mSize == 0) {
+                mCurrent = target;
+                return;
+            }
+            auto& slot = mSlots[++mCurrent & mMask];
+            for (size_t i = 0; i < slot.size();) {
+                if (slot[i].rounds > 0) {
+                    --slot[i].rounds;
+                    ++i;
+                    continue;
+                }
+                mDue.push_back(std::move(slot[i].value));
+                slot[i] = std::move(slot.back());
+                slot.pop_back();
+                --mSize;
+            }
+            // Fired after the slot is settled, since handlers may schedule into this very slot.
+            for (T& value : mDue) fire(std::move(value));
+            mDue.clear();
+        }
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return mSize; }
+    [[nodiscard]] bool   empty() const noexcept { return mSize == 0; }
+
+private:
+    struct Entry {
+        uint64_t rounds;
+        T        value;
+    };
+
+    [[nodiscard]] uint64_t ticksAt(Clock::time_point time) const noexcept {
+        return time <= mStart ? 0 : static_cast<uint64_t>((time - mStart) / mTick);
+    }
+
+    Clock::duration                 mTick;
+    std::vector<std::vector<Entry>> mSlots;
+    size_t                          mMask;
+    Clock::time_point               mStart;
+    uint64_t                        mCurrent = 0;
+    size_t                          mSize    = 0;
+    std::vector<T>                  mDue;
+};
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -0,0 +1,272 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include "Xxh3.hpp"
+#include <array>
+#include <bit>
+#include <cstring>
+
+namespace motdpe::detail {
+
+namespace {
+
+constexpr uint32_t XXH_PRIME32_1 = 0x9E3779B1;
+constexpr uint32_t XXH_PRIME32_2 = 0x85EBCA77;
+constexpr uint32_t XXH_PRIME32_3 = 0xC2B2AE3D;
+constexpr uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87;
+constexpr uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4F;
+constexpr uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9;
+constexpr uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63;
+constexpr uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5;
+constexpr uint64_t XXH_PRIME_MX1 = 0x165667919E3779F9;
+constexpr uint64_t XXH_PRIME_MX2 = 0x9FB21C651E98DF25;
+
+constexpr size_t XXH_STRIPE_LEN          = 64;
+constexpr size_t XXH_SECRET_CONSUME_RATE = 8;
+constexpr size_t XXH_ACC_NB              = 8;
+constexpr size_t XXH_MIDSIZE_MAX         = 240;
+constexpr size_t XXH_MIDSIZE_START       = 3;
+constexpr size_t XXH_MIDSIZE_LAST_OFFSET = 17;
+constexpr size_t XXH_SECRET_SIZE_MIN     = 136;
+constexpr size_t XXH_LAST_ACC_START      = 7;
+constexpr size_t XXH_MERGE_ACCS_START    = 11;
+
+constexpr std::array<uint8_t, 192> XXH_SECRET = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c, 0xde, 0xd4, 0x6d,
+    0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f, 0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0,
+    0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21, 0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0,
+    0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c, 0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b,
+    0x1b, 0x53, 0x2e, 0xa3, 0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac,
+    0xd8, 0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d, 0x8a, 0x51,
+    0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64, 0xea, 0xc5, 0xac, 0x83, 0x34,
+    0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb, 0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49,
+    0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e, 0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8,
+    0xd1, 0x7a, 0xd0, 0x31, 0xce, 0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b,
+    0x40, 0x7e,
+};
+
+const uint8_t* const SECRET = XXH_SECRET.data();
+
+// Loads are little-endian, as the algorithm defines them.
+uint32_t read32(const uint8_t* at) noexcept {
+    uint32_t value;
+    std::memcpy(&value, at, sizeof(value));
+    return std::endian::native == std::endian::little ? value : std::byteswap(value);
+}
+
+uint64_t read64(const uint8_t* at) noexcept {
+    uint64_t value;
+    std::memcpy(&value, at, sizeof(value));
+    return std::endian::native == std::endian::little ? value : std::byteswap(value);
+}
+
+Hash128 multiply(uint64_t a, uint64_t b) noexcept {
+#ifdef __SIZEOF_INT128__
+    __extension__ using Uint128 = unsigned __int128;
+    const auto product          = static_cast<Uint128>(a) * b;
+    return {static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64)};
+#else
+    const uint64_t lowLow   = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+    const uint64_t highLow  = (a >> 32) * (b & 0xFFFFFFFF);
+    const uint64_t lowHigh  = (a & 0xFFFFFFFF) * (b >> 32);
+    const uint64_t highHigh = (a >> 32) * (b >> 32);
+    const uint64_t cross    = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + lowHigh;
+    return {(cross << 32) | (lowLow & 0xFFFFFFFF), (highLow >> 32) + (cross >> 32) + highHigh};
+#endif
+}
+
+uint64_t multiplyFold(uint64_t a, uint64_t b) noexcept {
+    const Hash128 product = multiply(a, b);
+    return product.low ^ product.high;
+}
+
+uint64_t xxh64Avalanche(uint64_t hash) noexcept {
+    hash ^= hash >> 33;
+    hash *= XXH_PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= XXH_PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+uint64_t avalanche(uint64_t hash) noexcept {
+    hash ^= hash >> 37;
+    hash *= XXH_PRIME_MX1;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+uint64_t mix16(const uint8_t* input, const uint8_t* secret) noexcept {
+    return multiplyFold(read64(input) ^ read64(secret), read64(input + 8) ^ read64(secret + 8));
+}
+
+void mix32(Hash128& acc, const uint8_t* first, const uint8_t* second, const uint8_t* secret) noexcept {
+    acc.low  += mix16(first, secret);
+    acc.low  ^= read64(second) + read64(second + 8);
+    acc.high += mix16(second, secret + 16);
+    acc.high ^= read64(first) + read64(first + 8);
+}
+
+Hash128 finishMid(const Hash128& acc, size_t length) noexcept {
+    const uint64_t low  = acc.low + acc.high;
+    const uint64_t high = acc.low * XXH_PRIME64_1 + acc.high * XXH_PRIME64_4 + length * XXH_PRIME64_2;
+    return {avalanche(low), 0 - avalanche(high)};
+}
+
+Hash128 hash0To16(const uint8_t* input, size_t length) noexcept {
+    if (length > 8) {
+        const uint64_t flipLow  = read64(SECRET + 32) ^ read64(SECRET + 40);
+        const uint64_t flipHigh = read64(SECRET + 48) ^ read64(SECRET + 56);
+        const uint64_t first    = read64(input);
+        uint64_t       last     = read64(input + length - 8);
+
+        Hash128 m  = multiply(first ^ last ^ flipLow, XXH_PRIME64_1);
+        m.low     += static_cast<uint64_t>(length - 1) << 54;
+        last      ^= flipHigh;
+        m.high    += last + (last & 0xFFFFFFFF) * (XXH_PRIME32_2 - 1);
+        m.low     ^= std::byteswap(m.high);
+
+        Hash128 h  = multiply(m.low, XXH_PRIME64_2);
+        h.high    += m.high * XXH_PRIME64_2;
+        return {avalanche(h.low), avalanche(h.high)};
+    }
+    if (length >= 4) {
+        const uint64_t combined = read32(input) + (static_cast<uint64_t>(read32(input + length - 4)) << 32);
+        const uint64_t flip     = read64(SECRET + 16) ^ read64(SECRET + 24);
+
+        Hash128 m  = multiply(combined ^ flip, XXH_PRIME64_1 + (length << 2));
+        m.high    += m.low << 1;
+        m.low     ^= m.high >> 3;
+        m.low     ^= m.low >> 35;
+        m.low     *= XXH_PRIME_MX2;
+        m.low     ^= m.low >> 28;
+        return {m.low, avalanche(m.high)};
+    }
+    if (length > 0) {
+        const uint32_t combinedLow = static_cast<uint32_t>(input[0]) << 16
+                                   | static_cast<uint32_t>(input[length >> 1]) << 24 | input[length - 1]
+                                   | static_cast<uint32_t>(length) << 8;
+        const uint32_t combinedHigh = std::rotl(std::byteswap(combinedLow), 13);
+        const uint64_t flipLow      = read32(SECRET) ^ read32(SECRET + 4);
+        const uint64_t flipHigh     = read32(SECRET + 8) ^ read32(SECRET + 12);
+        return {xxh64Avalanche(combinedLow ^ flipLow), xxh64Avalanche(combinedHigh ^ flipHigh)};
+    }
+    return {
+        xxh64Avalanche(read64(SECRET + 64) ^ read64(SECRET + 72)),
+        xxh64Avalanche(read64(SECRET + 80) ^ read64(SECRET + 88)),
+    };
+}
+
+Hash128 hash17To128(const uint8_t* input, size_t length) noexcept {
+    Hash128 acc{length * XXH_PRIME64_1, 0};
+    if (length > 32) {
+        if (length > 64) {
+            if (length > 96) mix32(acc, input + 48, input + length - 64, SECRET + 96);
+            mix32(acc, input + 32, input + length - 48, SECRET + 64);
+        }
+        mix32(acc, input + 16, input + length - 32, SECRET + 32);
+    }
+    mix32(acc, input, input + length - 16, SECRET);
+    return finishMid(acc, length);
+}
+
+Hash128 hash129To240(const uint8_t* input, size_t length) noexcept {
+    Hash128 acc{length * XXH_PRIME64_1, 0};
+    for (size_t i = 0; i < 4; ++i) mix32(acc, input + 32 * i, input + 32 * i + 16, SECRET + 32 * i);
+    acc.low  = avalanche(acc.low);
+    acc.high = avalanche(acc.high);
+    for (size_t i = 4; i < length / 32; ++i) {
+        mix32(acc, input + 32 * i, input + 32 * i + 16, SECRET + XXH_MIDSIZE_START + 32 * (i - 4));
+    }
+    mix32(acc, input + length - 16, input + length - 32, SECRET + XXH_SECRET_SIZE_MIN - XXH_MIDSIZE_LAST_OFFSET - 16);
+    return finishMid(acc, length);
+}
+
+void accumulateStripe(std::array<uint64_t, XXH_ACC_NB>& acc, const uint8_t* input, const uint8_t* secret) noexcept {
+    for (size_t i = 0; i < XXH_ACC_NB; ++i) {
+        const uint64_t value  = read64(input + 8 * i);
+        const uint64_t keyed  = value ^ read64(secret + 8 * i);
+        acc[i ^ 1]           += value;
+        acc[i]               += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+    }
+}
+
+uint64_t mergeAccumulators(const std::array<uint64_t, XXH_ACC_NB>& acc, const uint8_t* secret, uint64_t start) {
+    uint64_t result = start;
+    for (size_t i = 0; i < XXH_ACC_NB / 2; ++i) {
+        result += multiplyFold(acc[2 * i] ^ read64(secret + 16 * i), acc[2 * i + 1] ^ read64(secret + 16 * i + 8));
+    }
+    return avalanche(result);
+}
+
+Hash128 hashLong(const uint8_t* input, size_t length) noexcept {
+    constexpr size_t STRIPES_PER_BLOCK = (XXH_SECRET.size() - XXH_STRIPE_LEN) / XXH_SECRET_CONSUME_RATE;
+    constexpr size_t BLOCK_LEN         = XXH_STRIPE_LEN * STRIPES_PER_BLOCK;
+
+    std::array<uint64_t, XXH_ACC_NB> acc = {
+        XXH_PRIME32_3,
+        XXH_PRIME64_1,
+        XXH_PRIME64_2,
+        XXH_PRIME64_3,
+        XXH_PRIME64_4,
+        XXH_PRIME32_2,
+        XXH_PRIME64_5,
+        XXH_PRIME32_1,
+    };
+
+    const size_t blocks = (length - 1) / BLOCK_LEN;
+    for (size_t block = 0; block < blocks; ++block) {
+        for (size_t stripe = 0; stripe < STRIPES_PER_BLOCK; ++stripe) {
+            accumulateStripe(
+                acc,
+                input + block * BLOCK_LEN + stripe * XXH_STRIPE_LEN,
+                SECRET + stripe * XXH_SECRET_CONSUME_RATE
+            );
+        }
+        const uint8_t* const scramble = SECRET + XXH_SECRET.size() - XXH_STRIPE_LEN;
+        for (size_t i = 0; i < XXH_ACC_NB; ++i) {
+            acc[i] ^= acc[i] >> 47;
+            acc[i] ^= read64(scramble + 8 * i);
+            acc[i] *= XXH_PRIME32_1;
+        }
+    }
+
+    const size_t stripes = ((length - 1) - blocks * BLOCK_LEN) / XXH_STRIPE_LEN;
+    for (size_t stripe = 0; stripe < stripes; ++stripe) {
+        accumulateStripe(
+            acc,
+            input + blocks * BLOCK_LEN + stripe * XXH_STRIPE_LEN,
+            SECRET + stripe * XXH_SECRET_CONSUME_RATE
+        );
+    }
+    accumulateStripe(
+        acc,
+        input + length - XXH_STRIPE_LEN,
+        SECRET + XXH_SECRET.size() - XXH_STRIPE_LEN - XXH_LAST_ACC_START
+    );
+
+    return {
+        mergeAccumulators(acc, SECRET + XXH_MERGE_ACCS_START, length * XXH_PRIME64_1),
+        mergeAccumulators(
+            acc,
+            SECRET + XXH_SECRET.size() - XXH_STRIPE_LEN - XXH_MERGE_ACCS_START,
+            ~(length * XXH_PRIME64_2)
+        ),
+    };
+}
+
+} // namespace
+
+Hash128 xxh3Hash128(std::span<const uint8_t> input) noexcept {
+    const size_t length = input.size();
+    if (length <= 16) return hash0To16(input.data(), length);
+    if (length <= 128) return hash17To128(input.data(), length);
+    if (length <= XXH_MIDSIZE_MAX) return hash129To240(input.data(), length);
+    return hashLong(input.data(), length);
+}
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -0,0 +1,23 @@
+// Copyright © 2025 GlacieTeam. All rights reserved.
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+// distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#include <cstdint>
+#include <span>
+
+namespace motdpe::detail {
+
+struct Hash128 {
+    uint64_t low;
+    uint64_t high;
+};
+
+// XXH3-128 with seed 0 and the default secret, bit-compatible with XXH3_128bits() from xxHash 0.8. Scalar code only:
+// pong payloads fall in the short and mid-size paths, where the hash is a handful of 64-bit multiplies.
+Hash128 xxh3Hash128(std::span<const uint8_t> input) noexcept;
+
+} // namespace motdpe::detail
\ No newline at end of file
@@ -1,5 +1,15 @@
 add_rules("mode.debug", "mode.release")
 
+option("sender")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Compile-check the stdexec sender header (include/motdpe/Sender.hpp)")
+option_end()
+
+if has_config("sender") then
+    add_requires("stdexec")
+end
+
 if is_plat("windows") then
     if not has_config("vs_runtime") then
         set_runtimes("MD")
@@ -55,4 +65,21 @@ target("MotdPE")
                 "-O3"
             )
         end
-    end
\ No newline at end of file
+    end
+
+if has_config("sender") then
+    target("SenderCheck")
+        set_kind("object")
+        set_languages("c++23")
+        add_includedirs("include")
+        add_files("checks/Sender.cpp")
+        add_packages("stdexec")
+        if not is_plat("windows") then
+            add_cxflags(
+                "-Wall",
+                "-pedantic",
+                "-fexceptions",
+                "-stdlib=libc++"
+            )
+        end
+end
\ No newline at end of file